@@ -4,21 +4,23 @@
 #include <type_traits>
 #include <iostream>
 #include <cmath>
+#include <iterator>
 
 #include "ubigint.h"
 
 /**
  * @brief Signed arbitrarily "big" precision integer class.
- * Uses std::deque<int> for dynamic storage. Stores magnitude by composition in unsigned UBigInt member.
+ * Uses binary limbs (see UBigInt) for dynamic storage. Stores magnitude by composition in unsigned UBigInt member.
  */
 
 class BigInt {
 public:
     BigInt() = default;
+    explicit BigInt(std::pmr::memory_resource *resource) : magnitude{resource} {}
     BigInt(const BigInt &rhs) = default;
     BigInt(BigInt &&rhs) = default;
     inline BigInt(char rhs, bool negative=0);
-    inline BigInt(std::string s);
+    inline BigInt(std::string_view s);
     inline BigInt(UBigInt rhs, bool negative=0);
     template <class T,
                 typename std::enable_if<std::is_integral<T>::value, int>::type* = nullptr>
@@ -31,7 +33,13 @@ public:
     inline BigInt& operator+=(const BigInt &rhs);
     inline BigInt& operator-=(const BigInt &rhs);
     inline BigInt& operator*=(const BigInt &rhs);
-    inline BigInt operator/=(const BigInt &rhs);
+    inline BigInt& operator/=(const BigInt &rhs);
+    inline BigInt& operator%=(const BigInt &rhs);
+    inline BigInt& operator&=(const BigInt &rhs);
+    inline BigInt& operator|=(const BigInt &rhs);
+    inline BigInt& operator^=(const BigInt &rhs);
+    inline BigInt& operator<<=(size_t m);
+    inline BigInt& operator>>=(size_t m);
     inline BigInt& operator++();
     inline BigInt& operator--();
     inline BigInt operator++(int);
@@ -40,6 +48,39 @@ public:
     inline friend BigInt operator-(const BigInt &lhs, const BigInt &rhs);
     inline friend BigInt operator*(const BigInt &lhs, const BigInt &rhs);
     inline friend BigInt operator/(const BigInt &lhs, const BigInt &rhs);
+    inline friend BigInt operator%(const BigInt &lhs, const BigInt &rhs);
+    inline friend BigInt operator+(BigInt &&lhs, const BigInt &rhs);
+    inline friend BigInt operator+(const BigInt &lhs, BigInt &&rhs);
+    inline friend BigInt operator+(BigInt &&lhs, BigInt &&rhs);
+    inline friend BigInt operator-(BigInt &&lhs, const BigInt &rhs);
+    inline friend BigInt operator-(const BigInt &lhs, BigInt &&rhs);
+    inline friend BigInt operator-(BigInt &&lhs, BigInt &&rhs);
+    inline friend BigInt operator*(BigInt &&lhs, const BigInt &rhs);
+    inline friend BigInt operator*(const BigInt &lhs, BigInt &&rhs);
+    inline friend BigInt operator*(BigInt &&lhs, BigInt &&rhs);
+    inline friend BigInt operator/(BigInt &&lhs, const BigInt &rhs);
+    inline friend BigInt operator/(const BigInt &lhs, BigInt &&rhs);
+    inline friend BigInt operator/(BigInt &&lhs, BigInt &&rhs);
+    inline friend BigInt operator%(BigInt &&lhs, const BigInt &rhs);
+    inline friend BigInt operator%(const BigInt &lhs, BigInt &&rhs);
+    inline friend BigInt operator%(BigInt &&lhs, BigInt &&rhs);
+    inline friend BigInt operator&(const BigInt &lhs, const BigInt &rhs);
+    inline friend BigInt operator|(const BigInt &lhs, const BigInt &rhs);
+    inline friend BigInt operator^(const BigInt &lhs, const BigInt &rhs);
+    inline friend BigInt operator~(const BigInt &rhs);
+    inline friend BigInt operator<<(const BigInt &lhs, size_t m);
+    inline friend BigInt operator>>(const BigInt &lhs, size_t m);
+    inline friend BigInt operator<<(BigInt &&lhs, size_t m);
+    inline friend BigInt operator>>(BigInt &&lhs, size_t m);
+    inline friend std::pair<BigInt, BigInt> divmod(const BigInt &lhs, const BigInt &rhs);
+    inline friend BigInt& addmul(BigInt &acc, const BigInt &lhs, const BigInt &rhs);
+    inline friend BigInt& submul(BigInt &acc, const BigInt &lhs, const BigInt &rhs);
+    inline friend BigInt& addmul_ui(BigInt &acc, const BigInt &lhs, std::uint64_t rhs);
+    inline friend BigInt& submul_ui(BigInt &acc, const BigInt &lhs, std::uint64_t rhs);
+    inline friend BigInt pow(const BigInt &base, const BigInt &exp);
+    inline friend BigInt pow(const BigInt &base, std::int64_t exp);
+    inline friend BigInt powmod(const BigInt &base, const BigInt &exp, const BigInt &mod);
+    inline friend int compare(const BigInt &lhs, const BigInt &rhs);
     inline friend bool operator>(const BigInt &lhs, const BigInt &rhs);
     inline friend bool operator<(const BigInt &lhs, const BigInt &rhs);
     inline friend bool operator==(const BigInt &lhs, const BigInt &rhs);
@@ -47,46 +88,81 @@ public:
     inline friend bool operator>=(const BigInt &lhs, const BigInt &rhs);
     inline friend bool operator<=(const BigInt &lhs, const BigInt &rhs);
     inline friend std::ostream& operator<<(std::ostream &out, const BigInt &rhs);
+    inline friend std::istream& operator>>(std::istream &in, BigInt &rhs);
+    inline friend std::to_chars_result to_chars(char *first, char *last, const BigInt &value);
+    inline friend std::from_chars_result from_chars(const char *first, const char *last, BigInt &value);
     inline BigInt& randomize(const size_t &length);
     inline BigInt& power(const BigInt &rhs);
+    inline BigInt& power(std::int64_t rhs);
+    inline BigInt& square();
     inline BigInt& shift10(int m=1);
     inline BigInt& abs();
+    inline bool test_bit(size_t i) const;
+    inline BigInt& set_bit(size_t i, bool value=true);
+    template <typename Iter>
+    inline static BigInt sum(Iter first, Iter last);
+    template <typename Iter>
+    inline static BigInt product(Iter first, Iter last);
+    template <typename Iter>
+    inline static BigInt sum(ThreadPool &pool, Iter first, Iter last);
+    template <typename Iter>
+    inline static BigInt product(ThreadPool &pool, Iter first, Iter last);
     inline BigInt& set_karatsuba_thres(size_t thres);
-    size_t get_length() {return magnitude.get_length();}
-    size_t get_karatsuba_thres() {return this->karatsuba_thres;}
+    inline BigInt& set_toom3_thres(size_t thres);
+    inline BigInt& set_toom4_thres(size_t thres);
+    inline BigInt& set_ntt_thres(size_t thres);
+    inline BigInt& set_parallel_thres(size_t thres);
+    size_t get_length() const {return magnitude.get_length();}
+    inline size_t hash() const;
+    size_t get_karatsuba_thres() {return this->mul_thres.karatsuba;}
+    size_t get_toom3_thres() {return this->mul_thres.toom3;}
+    size_t get_toom4_thres() {return this->mul_thres.toom4;}
+    size_t get_ntt_thres() {return this->mul_thres.ntt;}
+    size_t get_parallel_thres() {return this->mul_thres.parallel;}
+    std::pmr::memory_resource* get_resource() const {return magnitude.get_resource();}
 private:
     UBigInt magnitude;
     bool neg = false;
-    size_t karatsuba_thres = 48;
-    inline BigInt karatsuba(BigInt lhs, BigInt rhs);
+    MulThresholds mul_thres;
+    inline BigInt karatsuba(const BigInt &lhs, const BigInt &rhs);
+    inline BigInt& add_signed(const UBigInt &rhs, bool rhs_neg);
+    template <typename Op>
+    inline static void bitwise(BigInt &result, const BigInt &lhs, const BigInt &rhs, Op op);
+    inline static void add_product(BigInt &acc, const UBigInt &lhs, const UBigInt &rhs, bool product_neg);
+    template <typename Iter, typename Op>
+    inline static BigInt reduce(Iter first, size_t count, Op op);
+    inline static size_t reduce_depth(const ThreadPool &pool);
+    static constexpr size_t parallel_reduce_thres = 32;
+
+    template <class T>
+    friend struct LazyTraits;
 };
 
 
 /**
  * @brief BigInt single char ctor
  * @param rhs character to place into magnitude
- * @param negative negative sign (Default=0)
+ * @param negative negative sign (Default=0; ignored for zero)
  */
-inline BigInt::BigInt(char rhs, bool negative): magnitude{rhs}, neg{negative} {}
+inline BigInt::BigInt(char rhs, bool negative): magnitude{rhs} {
+    neg = negative && magnitude != 0;
+}
 
 
 /**
- * @brief BigInt std::string ctor
- * @param s std::string to parse into magnitude
+ * @brief BigInt string ctor; skips leading spaces and an optional sign, the rest must be decimal digits
+ * @param s String to parse into magnitude
  */
-inline BigInt::BigInt(std::string s) {
-    neg = false;
-    int i = 0;
-    while (s[i] == ' ') {
+inline BigInt::BigInt(std::string_view s) {
+    size_t i = 0;
+    while (i < s.size() && s[i] == ' ') {
         i++;
     }
-    if (s[i] == '-' || s[i] == '+') {
-        if (s[i] == '-') {
-            neg = true;
-        }
+    if (i < s.size() && (s[i] == '-' || s[i] == '+')) {
+        neg = s[i] == '-';
         i++;
     }
-    magnitude = s.substr(i, s.size());
+    magnitude = UBigInt(s.substr(i));
     if (magnitude == 0) {
         neg = false;
     }
@@ -96,9 +172,11 @@ inline BigInt::BigInt(std::string s) {
 /**
  * @brief BigInt unsigned conversion ctor
  * @param rhs UBigInt to construct
- * @param negative negative sign (Default=0)
+ * @param negative negative sign (Default=0; ignored for zero)
  */
-inline BigInt::BigInt(UBigInt rhs, bool negative) : magnitude{rhs}, neg{negative} {}
+inline BigInt::BigInt(UBigInt rhs, bool negative) : magnitude{std::move(rhs)} {
+    neg = negative && magnitude != 0;
+}
 
 
 /**
@@ -120,10 +198,12 @@ inline BigInt::BigInt(T rhs): magnitude{rhs} {
  * @brief BigInt generic iterator ctor
  * @param begin beginning iterator of range to copy
  * @param end end iterator of range to copy
- * @param negative negative sign (Default=0)
+ * @param negative negative sign (Default=0; ignored for zero)
  */
 template <typename Iter>
-inline BigInt::BigInt(Iter begin, Iter end, bool negative) : magnitude{begin, end}, neg{negative} {}
+inline BigInt::BigInt(Iter begin, Iter end, bool negative) : magnitude{begin, end} {
+    neg = negative && magnitude != 0;
+}
 
 /**
  * @brief Overloaded BigInt insertion operator prints sign and value of BigInt
@@ -133,57 +213,83 @@ inline BigInt::BigInt(Iter begin, Iter end, bool negative) : magnitude{begin, en
  */
 inline std::ostream& operator<<(std::ostream &out, const BigInt &rhs) {
     if (rhs.neg) {
-        std::cout << '-';
+        out << '-';
     }
-    std::cout << rhs.magnitude; 
+    out << rhs.magnitude;
     return out;
 }
 
 
 /**
- * @brief Overloaded BigInt addition assignment operator 
- * @param rhs BigInt reference added to *this
- * @returns Reference to modified instance 
+ * @brief Overloaded BigInt extraction operator reads an optional '-' and a run of decimal digits after leading whitespace; sets failbit if there are no digits
+ * @param in Input stream reference
+ * @param rhs BigInt reference read into
+ * @returns Reference to input stream
  */
-inline BigInt& BigInt::operator+=(const BigInt &rhs) {
-    if (neg && !rhs.neg) {
-        if (magnitude == rhs.magnitude) {
-            magnitude = {0};
-            neg = false;
-        }
-        else if (magnitude < rhs.magnitude) {
-            neg = false;
-            magnitude = rhs.magnitude - magnitude;
-        }
-        else if (magnitude > rhs.magnitude) {
-            neg = true;
-            magnitude -= rhs.magnitude;
-        }
+inline std::istream& operator>>(std::istream &in, BigInt &rhs) {
+    std::istream::sentry sentry{in};
+    if (!sentry) {
+        return in;
     }
-    else if (!neg && rhs.neg) {
-        if (magnitude == rhs.magnitude) {
-            magnitude = {0};
-            neg = false;
-        }
-        else if (magnitude < rhs.magnitude) {
-            neg = true;
-            magnitude = rhs.magnitude - magnitude;
-        }
-        else if (magnitude > rhs.magnitude) {
-            neg = false;
-            magnitude -= rhs.magnitude;
-        }
+    std::string digits;
+    if (in.peek() == '-') {
+        digits.push_back(static_cast<char>(in.get()));
     }
-    else if(!neg && !rhs.neg) {
-        neg = false;
-        magnitude += rhs.magnitude;
+    for (auto c = in.peek(); c >= '0' && c <= '9'; c = in.peek()) {
+        digits.push_back(static_cast<char>(in.get()));
+    }
+    if (from_chars(digits.data(), digits.data() + digits.size(), rhs).ec != std::errc{}) {
+        in.setstate(std::ios_base::failbit);
     }
+    return in;
+}
 
-    else {
-        neg = true;
-        magnitude += rhs.magnitude;
+
+/**
+ * @brief Writes the sign and decimal representation into [first, last)
+ * @param first Beginning of the output buffer
+ * @param last End of the output buffer
+ * @param value BigInt reference to print
+ * @returns {end of written characters, std::errc{}}, or {last, std::errc::value_too_large} if the buffer is too small
+ */
+inline std::to_chars_result to_chars(char *first, char *last, const BigInt &value) {
+    if (value.neg) {
+        if (first == last) {
+            return {last, std::errc::value_too_large};
+        }
+        *first++ = '-';
     }
-    return *this;
+    return to_chars(first, last, value.magnitude);
+}
+
+
+/**
+ * @brief Parses an optional '-' followed by the longest run of decimal digits at the start of [first, last)
+ * @param first Beginning of the input
+ * @param last End of the input
+ * @param value BigInt reference parsed into (unchanged on error)
+ * @returns {end of parsed characters, std::errc{}}, or {first, std::errc::invalid_argument} if no digits follow the optional sign
+ */
+inline std::from_chars_result from_chars(const char *first, const char *last, BigInt &value) {
+    bool negative = first != last && *first == '-';
+    UBigInt magnitude;
+    auto result = from_chars(first + negative, last, magnitude);
+    if (result.ec != std::errc{}) {
+        return {first, result.ec};
+    }
+    value.magnitude = std::move(magnitude);
+    value.neg = negative && value.magnitude != 0;
+    return result;
+}
+
+
+/**
+ * @brief Overloaded BigInt addition assignment operator 
+ * @param rhs BigInt reference added to *this
+ * @returns Reference to modified instance 
+ */
+inline BigInt& BigInt::operator+=(const BigInt &rhs) {
+    return add_signed(rhs.magnitude, rhs.neg);
 }
 
 
@@ -193,41 +299,32 @@ inline BigInt& BigInt::operator+=(const BigInt &rhs) {
  * @returns Reference to modified instance 
  */
 inline BigInt& BigInt::operator-=(const BigInt &rhs) {
-    if (neg && !rhs.neg) {
-        neg = true;
-        magnitude += rhs.magnitude;
+    return add_signed(rhs.magnitude, !rhs.neg);
+}
+
+
+/**
+ * @brief Utility method adding a signed magnitude to *this (core of += and -=); magnitudes are compared once, only when the signs differ
+ * @param rhs Magnitude added (may alias this magnitude)
+ * @param rhs_neg Sign of rhs
+ * @returns Reference to modified instance
+ */
+inline BigInt& BigInt::add_signed(const UBigInt &rhs, bool rhs_neg) {
+    if (neg == rhs_neg) {
+        magnitude += rhs;
+        return *this;
     }
-    else if (!neg && rhs.neg) {
+    int cmp = compare(magnitude, rhs);
+    if (cmp == 0) {
+        magnitude = {0};
         neg = false;
-        magnitude += rhs.magnitude;
     }
-    else if(!neg && !rhs.neg) {
-        if (magnitude == rhs.magnitude) {
-            magnitude = {0};
-            neg = false;
-        }
-        else if (magnitude < rhs.magnitude) {
-            neg = true;
-            magnitude = rhs.magnitude - magnitude;
-        }
-        else if (magnitude > rhs.magnitude) {
-            neg = false;
-            magnitude -= rhs.magnitude;
-        }
+    else if (cmp < 0) {
+        neg = rhs_neg;
+        magnitude.subtract_from(rhs);
     }
     else {
-        if (magnitude == rhs.magnitude) {
-            magnitude = {0};
-            neg = false;
-        }
-        else if (magnitude < rhs.magnitude) {
-            neg = false;
-            magnitude = rhs.magnitude - magnitude;
-        }
-        else if (magnitude > rhs.magnitude) {
-            neg = true;
-            magnitude -= rhs.magnitude;
-        }
+        magnitude.subtract(rhs);
     }
     return *this;
 }
@@ -239,9 +336,10 @@ inline BigInt& BigInt::operator-=(const BigInt &rhs) {
  * @returns Reference to modified instance 
  */
 inline BigInt& BigInt::operator*=(const BigInt &rhs) {
-    bool negative = (neg != rhs.neg); 
-    *this = karatsuba(*this, rhs);
-    neg = negative;
+    bool negative = (neg != rhs.neg);
+    MemoryScope scratch{MemoryScope::scratch()};
+    magnitude = karatsuba(*this, rhs).magnitude;
+    neg = negative && magnitude != 0;
     return *this;
 }
 
@@ -251,7 +349,7 @@ inline BigInt& BigInt::operator*=(const BigInt &rhs) {
  * @param rhs BigInt reference *this is divided by
  * @returns Reference to modified instance 
  */
-inline BigInt BigInt:: operator/=(const BigInt &rhs) {
+inline BigInt& BigInt::operator/=(const BigInt &rhs) {
     if (rhs.magnitude > magnitude) {
         magnitude = 0;
         neg = false;
@@ -264,6 +362,18 @@ inline BigInt BigInt:: operator/=(const BigInt &rhs) {
 }
 
 
+/**
+ * @brief Overloaded BigInt remainder assignment operator; truncating like built-in integers, so the remainder takes the sign of the dividend
+ * @param rhs BigInt reference *this is divided by
+ * @returns Reference to modified instance
+ */
+inline BigInt& BigInt::operator%=(const BigInt &rhs) {
+    magnitude %= rhs.magnitude;
+    neg = neg && magnitude != 0;
+    return *this;
+}
+
+
 /**
  * @brief Overloaded BigInt postfix increment operator 
  * @returns Reference to modified instance 
@@ -314,7 +424,7 @@ inline BigInt BigInt::operator--(int) {
  * @returns Copy of new instance 
  */
 inline BigInt operator+(const BigInt &lhs, const BigInt &rhs) {
-    return BigInt(lhs) += rhs;
+    return BigInt(lhs) + rhs;
 }
 
 
@@ -325,18 +435,21 @@ inline BigInt operator+(const BigInt &lhs, const BigInt &rhs) {
  * @returns Copy of new instance 
  */
 inline BigInt operator-(const BigInt &lhs, const BigInt &rhs) {
-    return BigInt(lhs) -= rhs;
+    return BigInt(lhs) - rhs;
 } 
 
 
 /**
- * @brief Overloaded BigInt binary multiplication operator 
+ * @brief Overloaded BigInt binary multiplication operator; x * x squares
  * @param lhs BigInt reference lhs component of product
  * @param rhs BigInt reference rhs component of product
  * @returns Copy of new instance 
  */
 inline BigInt operator*(const BigInt &lhs, const BigInt &rhs) {
-    return BigInt(lhs) *= rhs;
+    if (&lhs == &rhs) {
+        return std::move(BigInt(lhs).square());
+    }
+    return BigInt(lhs) * rhs;
 }
 
 
@@ -347,7 +460,276 @@ inline BigInt operator*(const BigInt &lhs, const BigInt &rhs) {
  * @returns Copy of new instance 
  */
 inline BigInt operator/(const BigInt &lhs, const BigInt &rhs) {
-    return BigInt(lhs) /= rhs;
+    return BigInt(lhs) / rhs;
+}
+
+
+/**
+ * @brief Overloaded BigInt binary remainder operator
+ * @param lhs BigInt reference lhs (numerator) of division
+ * @param rhs BigInt reference rhs (denominator) of division
+ * @returns Copy of new instance holding lhs - (lhs / rhs) * rhs
+ */
+inline BigInt operator%(const BigInt &lhs, const BigInt &rhs) {
+    return BigInt(lhs) % rhs;
+}
+
+
+/**
+ * @brief BigInt binary addition operator reusing the storage of a temporary lhs
+ * @param lhs BigInt rvalue lhs component of sum (result is built in its storage)
+ * @param rhs BigInt reference rhs component of sum
+ * @returns lhs holding the sum
+ */
+inline BigInt operator+(BigInt &&lhs, const BigInt &rhs) {
+    return std::move(lhs += rhs);
+}
+
+
+/**
+ * @brief BigInt binary addition operator reusing the storage of a temporary rhs; the result keeps the thresholds of lhs
+ * @param lhs BigInt reference lhs component of sum
+ * @param rhs BigInt rvalue rhs component of sum (result is built in its storage)
+ * @returns rhs holding the sum
+ */
+inline BigInt operator+(const BigInt &lhs, BigInt &&rhs) {
+    rhs.mul_thres = lhs.mul_thres;
+    return std::move(rhs += lhs);
+}
+
+
+/**
+ * @brief BigInt binary addition operator for two temporaries; reuses the storage of lhs
+ * @param lhs BigInt rvalue lhs component of sum
+ * @param rhs BigInt rvalue rhs component of sum
+ * @returns lhs holding the sum
+ */
+inline BigInt operator+(BigInt &&lhs, BigInt &&rhs) {
+    return std::move(lhs += rhs);
+}
+
+
+/**
+ * @brief BigInt binary subtraction operator reusing the storage of a temporary lhs
+ * @param lhs BigInt rvalue lhs component of difference (result is built in its storage)
+ * @param rhs BigInt reference rhs component of difference
+ * @returns lhs holding the difference
+ */
+inline BigInt operator-(BigInt &&lhs, const BigInt &rhs) {
+    return std::move(lhs -= rhs);
+}
+
+
+/**
+ * @brief BigInt binary subtraction operator reusing the storage of a temporary rhs (computes -(rhs - lhs)); the result keeps the thresholds of lhs
+ * @param lhs BigInt reference lhs component of difference
+ * @param rhs BigInt rvalue rhs component of difference (result is built in its storage)
+ * @returns rhs holding the difference
+ */
+inline BigInt operator-(const BigInt &lhs, BigInt &&rhs) {
+    rhs.mul_thres = lhs.mul_thres;
+    rhs -= lhs;
+    rhs.neg = !rhs.neg && rhs.magnitude != 0;
+    return std::move(rhs);
+}
+
+
+/**
+ * @brief BigInt binary subtraction operator for two temporaries; reuses the storage of lhs
+ * @param lhs BigInt rvalue lhs component of difference
+ * @param rhs BigInt rvalue rhs component of difference
+ * @returns lhs holding the difference
+ */
+inline BigInt operator-(BigInt &&lhs, BigInt &&rhs) {
+    return std::move(lhs -= rhs);
+}
+
+
+/**
+ * @brief BigInt binary multiplication operator reusing the storage of a temporary lhs for the product
+ * @param lhs BigInt rvalue lhs component of product
+ * @param rhs BigInt reference rhs component of product
+ * @returns lhs holding the product
+ */
+inline BigInt operator*(BigInt &&lhs, const BigInt &rhs) {
+    return std::move(lhs *= rhs);
+}
+
+
+/**
+ * @brief BigInt binary multiplication operator reusing the storage of a temporary rhs for the product; multiplies with the thresholds of lhs
+ * @param lhs BigInt reference lhs component of product
+ * @param rhs BigInt rvalue rhs component of product
+ * @returns rhs holding the product
+ */
+inline BigInt operator*(const BigInt &lhs, BigInt &&rhs) {
+    rhs.mul_thres = lhs.mul_thres;
+    return std::move(rhs *= lhs);
+}
+
+
+/**
+ * @brief BigInt binary multiplication operator for two temporaries; reuses the storage of lhs
+ * @param lhs BigInt rvalue lhs component of product
+ * @param rhs BigInt rvalue rhs component of product
+ * @returns lhs holding the product
+ */
+inline BigInt operator*(BigInt &&lhs, BigInt &&rhs) {
+    return std::move(lhs *= rhs);
+}
+
+
+/**
+ * @brief BigInt binary division operator reusing the storage of a temporary lhs for the quotient
+ * @param lhs BigInt rvalue lhs (numerator) of division
+ * @param rhs BigInt reference rhs (denominator) of division
+ * @returns lhs holding the quotient
+ */
+inline BigInt operator/(BigInt &&lhs, const BigInt &rhs) {
+    return std::move(lhs /= rhs);
+}
+
+
+/**
+ * @brief BigInt binary division operator reusing the storage of a temporary rhs for the quotient; the result keeps the thresholds of lhs
+ * @param lhs BigInt reference lhs (numerator) of division
+ * @param rhs BigInt rvalue rhs (denominator) of division
+ * @returns rhs holding the quotient
+ */
+inline BigInt operator/(const BigInt &lhs, BigInt &&rhs) {
+    bool negative = lhs.neg != rhs.neg;
+    rhs.magnitude = lhs.magnitude / std::move(rhs.magnitude);
+    rhs.neg = negative && rhs.magnitude != 0;
+    rhs.mul_thres = lhs.mul_thres;
+    return std::move(rhs);
+}
+
+
+/**
+ * @brief BigInt binary division operator for two temporaries; reuses the storage of lhs
+ * @param lhs BigInt rvalue lhs (numerator) of division
+ * @param rhs BigInt rvalue rhs (denominator) of division
+ * @returns lhs holding the quotient
+ */
+inline BigInt operator/(BigInt &&lhs, BigInt &&rhs) {
+    return std::move(lhs /= rhs);
+}
+
+
+/**
+ * @brief BigInt binary remainder operator reusing the storage of a temporary lhs for the remainder
+ * @param lhs BigInt rvalue lhs (numerator) of division
+ * @param rhs BigInt reference rhs (denominator) of division
+ * @returns lhs holding lhs - (lhs / rhs) * rhs
+ */
+inline BigInt operator%(BigInt &&lhs, const BigInt &rhs) {
+    return std::move(lhs %= rhs);
+}
+
+
+/**
+ * @brief BigInt binary remainder operator reusing the storage of a temporary rhs for the remainder; the result keeps the thresholds of lhs
+ * @param lhs BigInt reference lhs (numerator) of division
+ * @param rhs BigInt rvalue rhs (denominator) of division
+ * @returns rhs holding lhs - (lhs / rhs) * rhs
+ */
+inline BigInt operator%(const BigInt &lhs, BigInt &&rhs) {
+    rhs.magnitude = lhs.magnitude % std::move(rhs.magnitude);
+    rhs.neg = lhs.neg && rhs.magnitude != 0;
+    rhs.mul_thres = lhs.mul_thres;
+    return std::move(rhs);
+}
+
+
+/**
+ * @brief BigInt binary remainder operator for two temporaries; reuses the storage of lhs
+ * @param lhs BigInt rvalue lhs (numerator) of division
+ * @param rhs BigInt rvalue rhs (denominator) of division
+ * @returns lhs holding lhs - (lhs / rhs) * rhs
+ */
+inline BigInt operator%(BigInt &&lhs, BigInt &&rhs) {
+    return std::move(lhs %= rhs);
+}
+
+
+/**
+ * @brief Quotient and remainder from a single division pass; the quotient truncates toward zero and the remainder takes the sign of lhs
+ * @param lhs BigInt reference lhs (numerator) of division
+ * @param rhs BigInt reference rhs (denominator) of division
+ * @returns Pair of quotient and remainder
+ */
+inline std::pair<BigInt, BigInt> divmod(const BigInt &lhs, const BigInt &rhs) {
+    auto [quo, rem] = divmod(lhs.magnitude, rhs.magnitude);
+    bool quo_neg = lhs.neg != rhs.neg && quo != 0;
+    bool rem_neg = lhs.neg && rem != 0;
+    return {BigInt(std::move(quo), quo_neg), BigInt(std::move(rem), rem_neg)};
+}
+
+
+/**
+ * @brief Fused multiply-add acc += lhs * rhs using acc's multiplication thresholds; small products are accumulated into acc's storage without a temporary
+ * @param acc BigInt reference accumulated into
+ * @param lhs Left hand factor
+ * @param rhs Right hand factor
+ * @returns Reference to acc
+ */
+inline BigInt& addmul(BigInt &acc, const BigInt &lhs, const BigInt &rhs) {
+    BigInt::add_product(acc, lhs.magnitude, rhs.magnitude, lhs.neg != rhs.neg);
+    return acc;
+}
+
+
+/**
+ * @brief Fused multiply-subtract acc -= lhs * rhs using acc's multiplication thresholds
+ * @param acc BigInt reference subtracted from
+ * @param lhs Left hand factor
+ * @param rhs Right hand factor
+ * @returns Reference to acc
+ */
+inline BigInt& submul(BigInt &acc, const BigInt &lhs, const BigInt &rhs) {
+    BigInt::add_product(acc, lhs.magnitude, rhs.magnitude, lhs.neg == rhs.neg);
+    return acc;
+}
+
+
+/**
+ * @brief Fused multiply-add by a native scalar, acc += lhs * rhs
+ * @param acc BigInt reference accumulated into
+ * @param lhs Left hand factor
+ * @param rhs Scalar factor
+ * @returns Reference to acc
+ */
+inline BigInt& addmul_ui(BigInt &acc, const BigInt &lhs, std::uint64_t rhs) {
+    BigInt::add_product(acc, lhs.magnitude, UBigInt(rhs), lhs.neg);
+    return acc;
+}
+
+
+/**
+ * @brief Fused multiply-subtract by a native scalar, acc -= lhs * rhs
+ * @param acc BigInt reference subtracted from
+ * @param lhs Left hand factor
+ * @param rhs Scalar factor
+ * @returns Reference to acc
+ */
+inline BigInt& submul_ui(BigInt &acc, const BigInt &lhs, std::uint64_t rhs) {
+    BigInt::add_product(acc, lhs.magnitude, UBigInt(rhs), !lhs.neg);
+    return acc;
+}
+
+
+/**
+ * @brief Three-way comparison in a single pass; signs first, then one magnitude comparison
+ * @param lhs BigInt reference lhs of comparison
+ * @param rhs BigInt reference rhs of comparison
+ * @returns Negative if lhs < rhs, zero if lhs == rhs, positive if lhs > rhs
+ */
+inline int compare(const BigInt &lhs, const BigInt &rhs) {
+    if (lhs.neg != rhs.neg) {
+        return lhs.neg ? -1 : 1;
+    }
+    int cmp = compare(lhs.magnitude, rhs.magnitude);
+    return lhs.neg ? -cmp : cmp;
 }
 
 
@@ -357,20 +739,8 @@ inline BigInt operator/(const BigInt &lhs, const BigInt &rhs) {
  * @param rhs BigInt reference rhs of comparison
  * @returns True if lhs > rhs 
  */
-
 inline bool operator>(const BigInt &lhs, const BigInt &rhs) {
-    if (lhs.neg && !rhs.neg) {
-        return false;
-    }
-    else if (!lhs.neg && rhs.neg) {
-        return true;
-    }
-    else if (lhs.neg && rhs.neg) {
-        return (lhs.magnitude < rhs.magnitude);
-    }
-    else {
-        return (lhs.magnitude > rhs.magnitude);
-    }
+    return compare(lhs, rhs) > 0;
 }
 
 
@@ -381,18 +751,7 @@ inline bool operator>(const BigInt &lhs, const BigInt &rhs) {
  * @returns True if lhs < rhs 
  */
 inline bool operator<(const BigInt &lhs, const BigInt &rhs) {
-    if (lhs.neg && !rhs.neg) {
-        return true;
-    }
-    if (!lhs.neg && rhs.neg) {
-        return false;
-    }
-    if (lhs.neg && rhs.neg) {
-        return (lhs.magnitude > rhs.magnitude);
-    }
-    else {
-        return (lhs.magnitude < rhs.magnitude);
-    }
+    return compare(lhs, rhs) < 0;
 }
 
 
@@ -403,10 +762,7 @@ inline bool operator<(const BigInt &lhs, const BigInt &rhs) {
  * @returns True if lhs magnitude and sign == rhs magnitude and sign
  */
 inline bool operator==(const BigInt &lhs, const BigInt &rhs) {
-    if (lhs.neg != rhs.neg) {
-        return false;
-    }
-    return (lhs.magnitude == rhs.magnitude);
+    return lhs.neg == rhs.neg && lhs.magnitude == rhs.magnitude;
 }
 
 
@@ -425,10 +781,10 @@ inline bool operator!=(const BigInt &lhs, const BigInt &rhs) {
  * @brief Overloaded BigInt greater than or equal to comparison operator 
  * @param lhs BigInt reference lhs of comparison
  * @param rhs BigInt reference rhs of comparison
- * @returns True if comparison operator == returns true or operator > returns true
+ * @returns True if lhs >= rhs
  */
 inline bool operator>=(const BigInt &lhs, const BigInt &rhs) {
-    return (lhs == rhs || lhs > rhs);
+    return compare(lhs, rhs) >= 0;
 }
 
 
@@ -436,60 +792,315 @@ inline bool operator>=(const BigInt &lhs, const BigInt &rhs) {
  * @brief Overloaded BigInt less than or equal to comparison operator 
  * @param lhs BigInt reference lhs of comparison
  * @param rhs BigInt reference rhs of comparison
- * @returns True if comparison operator == returns true or operator < returns true
+ * @returns True if lhs <= rhs
  */
 inline bool operator<=(const BigInt &lhs, const BigInt &rhs) {
-    return (lhs == rhs || lhs < rhs);
+    return compare(lhs, rhs) <= 0;
 }
 
 
 /**
- * @brief Sets karatsuba_thres which is minimum size(magnitude) that uses karatsuba vs. long multiplication
- * @param thres Threshold size
- * @returns Reference to adjusted instance
+ * @brief Hash of the value for unordered containers; the magnitude's hash, complemented for negative values
+ * @returns Hash value (equal values hash equally)
  */
-inline BigInt& BigInt::set_karatsuba_thres(size_t thres) {
-    this->karatsuba_thres = thres;
+inline size_t BigInt::hash() const {
+    size_t h = magnitude.hash();
+    return neg ? ~h : h;
+}
+
+
+/**
+ * @brief Overloaded BigInt bitwise and assignment operator (two's complement semantics, see bitwise)
+ * @param rhs BigInt reference and-ed into *this
+ * @returns Reference to modified instance
+ */
+inline BigInt& BigInt::operator&=(const BigInt &rhs) {
+    BigInt::bitwise(*this, *this, rhs, std::bit_and<UBigInt::limb_t>());
     return *this;
 }
 
 
 /**
- * @brief Karatsuba recursive multiplication algorithm which recurses at size(magnitude) > karatsuba_thres. Base condition calls long multiplication
- * @param lhs Left hand portion of multiplication algorithm
- * @param rhs Right hand portion of multiplication algorithm
- * @returns Copy of BigInt product
+ * @brief Overloaded BigInt bitwise or assignment operator (two's complement semantics, see bitwise)
+ * @param rhs BigInt reference or-ed into *this
+ * @returns Reference to modified instance
+ */
+inline BigInt& BigInt::operator|=(const BigInt &rhs) {
+    BigInt::bitwise(*this, *this, rhs, std::bit_or<UBigInt::limb_t>());
+    return *this;
+}
+
+
+/**
+ * @brief Overloaded BigInt bitwise exclusive or assignment operator (two's complement semantics, see bitwise)
+ * @param rhs BigInt reference xor-ed into *this
+ * @returns Reference to modified instance
+ */
+inline BigInt& BigInt::operator^=(const BigInt &rhs) {
+    BigInt::bitwise(*this, *this, rhs, std::bit_xor<UBigInt::limb_t>());
+    return *this;
+}
+
+
+/**
+ * @brief Overloaded BigInt left shift assignment operator; multiplies by 2^m
+ * @param m Number of bits to shift by
+ * @returns Reference to modified instance
  */
-inline BigInt BigInt::karatsuba(BigInt lhs, BigInt rhs) {
-    if (lhs.get_length() < karatsuba_thres || rhs.get_length() < karatsuba_thres) {
-        return lhs.magnitude *= rhs.magnitude;
+inline BigInt& BigInt::operator<<=(size_t m) {
+    magnitude <<= m;
+    return *this;
+}
+
+
+/**
+ * @brief Overloaded BigInt right shift assignment operator; arithmetic shift, i.e. floor division by 2^m (-1 >> m == -1)
+ * @param m Number of bits to shift by
+ * @returns Reference to modified instance
+ */
+inline BigInt& BigInt::operator>>=(size_t m) {
+    // floor(-a / 2^m) == -ceil(a / 2^m)
+    bool round_up = neg && magnitude.any_bit_below(m);
+    magnitude >>= m;
+    if (round_up) {
+        ++magnitude;
     }
-    int m = std::max(lhs.get_length(), rhs.get_length());
-    int m2 = std::ceil(m / 2);
+    neg = neg && !magnitude.num.empty();
+    return *this;
+}
+
+
+/**
+ * @brief Overloaded BigInt bitwise and operator (two's complement semantics, see bitwise)
+ * @param lhs BigInt reference lhs operand
+ * @param rhs BigInt reference rhs operand
+ * @returns Copy of new instance
+ */
+inline BigInt operator&(const BigInt &lhs, const BigInt &rhs) {
+    BigInt result;
+    BigInt::bitwise(result, lhs, rhs, std::bit_and<UBigInt::limb_t>());
+    return result;
+}
+
+
+/**
+ * @brief Overloaded BigInt bitwise or operator (two's complement semantics, see bitwise)
+ * @param lhs BigInt reference lhs operand
+ * @param rhs BigInt reference rhs operand
+ * @returns Copy of new instance
+ */
+inline BigInt operator|(const BigInt &lhs, const BigInt &rhs) {
+    BigInt result;
+    BigInt::bitwise(result, lhs, rhs, std::bit_or<UBigInt::limb_t>());
+    return result;
+}
 
-    BigInt high1, low1, high2, low2;
-    if (lhs.magnitude.get_length() < m2) {
-        high1 = 0;
-        low1 = lhs;
+
+/**
+ * @brief Overloaded BigInt bitwise exclusive or operator (two's complement semantics, see bitwise)
+ * @param lhs BigInt reference lhs operand
+ * @param rhs BigInt reference rhs operand
+ * @returns Copy of new instance
+ */
+inline BigInt operator^(const BigInt &lhs, const BigInt &rhs) {
+    BigInt result;
+    BigInt::bitwise(result, lhs, rhs, std::bit_xor<UBigInt::limb_t>());
+    return result;
+}
+
+
+/**
+ * @brief Overloaded BigInt bitwise not operator; in two's complement ~x == -x - 1
+ * @param rhs BigInt reference operand
+ * @returns Copy of new instance
+ */
+inline BigInt operator~(const BigInt &rhs) {
+    BigInt result{rhs};
+    if (result.neg) {
+        --result.magnitude;
+        result.neg = false;
     }
     else {
-        high1 = lhs.magnitude.get_slice(0, lhs.magnitude.get_length() - m2);
-        low1 = lhs.magnitude.get_slice(lhs.magnitude.get_length() - m2, lhs.magnitude.get_length());
+        ++result.magnitude;
+        result.neg = true;
+    }
+    return result;
+}
+
+
+/**
+ * @brief Overloaded BigInt left shift operator
+ * @param lhs BigInt reference shifted
+ * @param m Number of bits to shift by
+ * @returns Copy of new instance holding lhs * 2^m
+ */
+inline BigInt operator<<(const BigInt &lhs, size_t m) {
+    return BigInt(lhs) << m;
+}
+
+
+/**
+ * @brief Overloaded BigInt right shift operator; arithmetic shift (rounds toward negative infinity)
+ * @param lhs BigInt reference shifted
+ * @param m Number of bits to shift by
+ * @returns Copy of new instance holding floor(lhs / 2^m)
+ */
+inline BigInt operator>>(const BigInt &lhs, size_t m) {
+    return BigInt(lhs) >> m;
+}
+
+
+/**
+ * @brief BigInt left shift operator reusing the storage of a temporary lhs
+ * @param lhs BigInt rvalue shifted (result is built in its storage)
+ * @param m Number of bits to shift by
+ * @returns lhs holding lhs * 2^m
+ */
+inline BigInt operator<<(BigInt &&lhs, size_t m) {
+    return std::move(lhs <<= m);
+}
+
+
+/**
+ * @brief BigInt right shift operator reusing the storage of a temporary lhs; arithmetic shift (rounds toward negative infinity)
+ * @param lhs BigInt rvalue shifted (result is built in its storage)
+ * @param m Number of bits to shift by
+ * @returns lhs holding floor(lhs / 2^m)
+ */
+inline BigInt operator>>(BigInt &&lhs, size_t m) {
+    return std::move(lhs >>= m);
+}
+
+
+/**
+ * @brief Tests a single bit of the infinite two's complement representation (negative values have all high bits set)
+ * @param i Bit index (0 is the least significant)
+ * @returns Value of bit i
+ */
+inline bool BigInt::test_bit(size_t i) const {
+    if (!neg) {
+        return magnitude.test_bit(i);
+    }
+    // -a == ~(a - 1): below the lowest set bit t of a the bits are 0, bit t is 1 and the bits above t are those of a inverted
+    const LimbVector &x = magnitude.num;
+    size_t k = 0;
+    while (x[k] == 0) {
+        k++;
     }
-    if (rhs.magnitude.get_length() < m2) {
-        high2 = 0;
-        low2 = rhs;
+    size_t t = k * UBigInt::limb_bits + __builtin_ctzll(x[k]);
+    return i == t || (i > t && !magnitude.test_bit(i));
+}
+
+
+/**
+ * @brief Sets or clears a single bit of the infinite two's complement representation
+ * @param i Bit index (0 is the least significant)
+ * @param value New value of bit i
+ * @returns Reference to modified instance
+ */
+inline BigInt& BigInt::set_bit(size_t i, bool value) {
+    if (!neg) {
+        magnitude.set_bit(i, value);
+        return *this;
+    }
+    if (test_bit(i) == value) {
+        return *this;
+    }
+    // setting a clear bit of -a adds 2^i (a -= 2^i), clearing a set bit subtracts 2^i (a += 2^i); the value stays negative
+    LimbVector &x = magnitude.num;
+    size_t k = i / UBigInt::limb_bits;
+    UBigInt::limb_t bit = UBigInt::limb_t(1) << (i % UBigInt::limb_bits);
+    if (value) {
+        UBigInt::sub_1(x.data() + k, x.data() + k, x.size() - k, bit);
+        magnitude.trim();
     }
     else {
-        high2 = rhs.magnitude.get_slice(0, rhs.magnitude.get_length() - m2);
-        low2 = rhs.magnitude.get_slice(rhs.magnitude.get_length() - m2, rhs.magnitude.get_length());
+        if (x.size() <= k) {
+            x.resize(k + 1, 0);
+        }
+        if (UBigInt::limb_t carry = UBigInt::add_1(x.data() + k, x.data() + k, x.size() - k, bit)) {
+            x.push_back(carry);
+        }
     }
+    return *this;
+}
 
-    BigInt z0 = karatsuba(low1, low2);
-    BigInt z1 = karatsuba((low1 + high1), (low2 + high2));
-    BigInt z2 = karatsuba(high1, high2);
 
-    return ((z2.shift10(m2*2)) + ((z1-z2-z0).shift10(m2)) + z0);
+/**
+ * @brief Sets karatsuba threshold which is minimum size(magnitude) in limbs that uses karatsuba vs. long multiplication
+ * @param thres Threshold size
+ * @returns Reference to adjusted instance
+ */
+inline BigInt& BigInt::set_karatsuba_thres(size_t thres) {
+    this->mul_thres.karatsuba = thres;
+    return *this;
+}
+
+
+/**
+ * @brief Sets toom3 threshold which is minimum size(magnitude) in limbs that uses Toom-Cook 3-way vs. karatsuba
+ * @param thres Threshold size
+ * @returns Reference to adjusted instance
+ */
+inline BigInt& BigInt::set_toom3_thres(size_t thres) {
+    this->mul_thres.toom3 = thres;
+    return *this;
+}
+
+
+/**
+ * @brief Sets toom4 threshold which is minimum size(magnitude) in limbs that uses Toom-Cook 4-way vs. Toom-Cook 3-way
+ * @param thres Threshold size
+ * @returns Reference to adjusted instance
+ */
+inline BigInt& BigInt::set_toom4_thres(size_t thres) {
+    this->mul_thres.toom4 = thres;
+    return *this;
+}
+
+
+/**
+ * @brief Sets ntt threshold which is minimum size(magnitude) in limbs that uses NTT multiplication vs. Toom-Cook
+ * @param thres Threshold size
+ * @returns Reference to adjusted instance
+ */
+inline BigInt& BigInt::set_ntt_thres(size_t thres) {
+    this->mul_thres.ntt = thres;
+    return *this;
+}
+
+
+/**
+ * @brief Sets parallel threshold which is minimum size(magnitude) in limbs whose sub-products run as parallel tasks under a ParallelScope
+ * @param thres Threshold size
+ * @returns Reference to adjusted instance
+ */
+inline BigInt& BigInt::set_parallel_thres(size_t thres) {
+    this->mul_thres.parallel = thres;
+    return *this;
+}
+
+
+/**
+ * @brief Multiplication entry point; dispatches between long multiplication, Karatsuba, Toom-Cook and NTT using this instance's thresholds
+ * @param lhs Left hand portion of multiplication algorithm
+ * @param rhs Right hand portion of multiplication algorithm
+ * @returns Copy of BigInt product magnitude
+ */
+inline BigInt BigInt::karatsuba(const BigInt &lhs, const BigInt &rhs) {
+    return UBigInt::multiply(lhs.magnitude, rhs.magnitude, mul_thres);
+}
+
+
+/**
+ * @brief Adds a signed product into acc's magnitude in place (see UBigInt::signed_add_product) using acc's multiplication thresholds
+ * @param acc BigInt accumulated into
+ * @param lhs Left hand factor magnitude
+ * @param rhs Right hand factor magnitude
+ * @param product_neg Sign of the product
+ */
+inline void BigInt::add_product(BigInt &acc, const UBigInt &lhs, const UBigInt &rhs, bool product_neg) {
+    UBigInt::signed_add_product(acc.magnitude, acc.neg, lhs, rhs, product_neg, acc.mul_thres);
 }
 
 
@@ -506,29 +1117,94 @@ inline BigInt& BigInt::randomize(const size_t &length) {
 
 
 /**
- * @brief  BigInt's exponent utility method
+ * @brief  BigInt's exponent utility method (sliding window square-and-multiply); negative exponents truncate 1/base^|rhs| toward zero
  * @param rhs Exponent to raise base *this by
  * @returns Reference to modified BigInt
+ * @throws std::runtime_error if *this is zero and rhs is negative (division by zero)
  */
 inline BigInt& BigInt::power(const BigInt &rhs) {
-    if (rhs == 0) {
-        *this = {1};
-    }
-    else if (rhs < 0) {
-        *this = {0}; 
+    bool odd = !rhs.magnitude.num.empty() && (rhs.magnitude.num[0] & 1);
+    if (rhs.neg) {
+        if (magnitude.num.empty()) {
+            throw std::runtime_error("Division by zero in BigInt power.");
+        }
+        if (magnitude != 1) {
+            magnitude = 0;
+        }
     }
     else {
-        const BigInt base = *this;
-        UBigInt count {0};
-        while (count < rhs-1) {
-            *this *= base;
-            count++;
-        }
+        MemoryScope scratch{MemoryScope::scratch()};
+        const MulThresholds &thres = mul_thres;
+        magnitude = UBigInt::window_power(magnitude, rhs.magnitude, [&thres](const UBigInt &a, const UBigInt &b) {return UBigInt::multiply(a, b, thres);});
     }
+    neg = neg && odd && magnitude != 0;
     return *this;
 }
 
 
+/**
+ * @brief  Squares *this in place with the dedicated squaring algorithms
+ * @returns Reference to modified BigInt
+ */
+inline BigInt& BigInt::square() {
+    MemoryScope scratch{MemoryScope::scratch()};
+    magnitude = UBigInt::multiply(magnitude, magnitude, mul_thres);
+    neg = false;
+    return *this;
+}
+
+
+/**
+ * @brief  BigInt's exponent utility method for a native exponent
+ * @param rhs Exponent to raise base *this by
+ * @returns Reference to modified BigInt
+ */
+inline BigInt& BigInt::power(std::int64_t rhs) {
+    return power(BigInt{rhs});
+}
+
+
+/**
+ * @brief Raises base to exp without modifying base
+ * @param base BigInt reference to raise
+ * @param exp Exponent
+ * @returns Copy of new instance holding base^exp
+ */
+inline BigInt pow(const BigInt &base, const BigInt &exp) {
+    return BigInt(base).power(exp);
+}
+
+
+/**
+ * @brief Raises base to a native exponent without modifying base
+ * @param base BigInt reference to raise
+ * @param exp Exponent
+ * @returns Copy of new instance holding base^exp
+ */
+inline BigInt pow(const BigInt &base, std::int64_t exp) {
+    return BigInt(base).power(exp);
+}
+
+
+/**
+ * @brief Modular exponentiation without materializing base^exp
+ * @param base BigInt reference to raise
+ * @param exp Exponent (non-negative)
+ * @param mod Modulus (non-zero); only its magnitude is used
+ * @returns base^exp mod |mod| as the least non-negative residue
+ */
+inline BigInt powmod(const BigInt &base, const BigInt &exp, const BigInt &mod) {
+    if (exp.neg) {
+        throw std::runtime_error("Negative exponent in BigInt powmod.");
+    }
+    UBigInt result = powmod(base.magnitude, exp.magnitude, mod.magnitude);
+    if (base.neg && exp.magnitude % 2 == 1 && result != 0) {
+        result = mod.magnitude - result;
+    }
+    return BigInt(std::move(result));
+}
+
+
 /**
  * @brief  BigInt's absolute value utility method
  * @returns Reference to modified BigInt
@@ -550,4 +1226,160 @@ inline BigInt& BigInt::shift10(int m) {
 }
 
 
+/**
+ * @brief Sum of a range as a balanced tree of additions; subtrees run as parallel tasks under an active ParallelScope
+ * @param first Iterator to the first element (BigInt or convertible to BigInt)
+ * @param last Iterator past the last element
+ * @returns Sum of the range (0 if empty)
+ */
+template <typename Iter>
+inline BigInt BigInt::sum(Iter first, Iter last) {
+    size_t count = std::distance(first, last);
+    if (count == 0) {
+        return 0;
+    }
+    return reduce(first, count, [](BigInt &&lhs, const BigInt &rhs) {return std::move(lhs) + rhs;});
+}
+
+
+/**
+ * @brief Product of a range as a balanced product tree, so the multiplications stay balanced and large ones reach
+ * Karatsuba, Toom-Cook and NTT; subtrees run as parallel tasks under an active ParallelScope
+ * @param first Iterator to the first element (BigInt or convertible to BigInt)
+ * @param last Iterator past the last element
+ * @returns Product of the range (1 if empty)
+ */
+template <typename Iter>
+inline BigInt BigInt::product(Iter first, Iter last) {
+    size_t count = std::distance(first, last);
+    if (count == 0) {
+        return 1;
+    }
+    return reduce(first, count, [](BigInt &&lhs, const BigInt &rhs) {return std::move(lhs) * rhs;});
+}
+
+
+/**
+ * @brief Parallel sum of a range; subtrees run as tasks on pool
+ * @param pool Thread pool to run on
+ * @param first Iterator to the first element (BigInt or convertible to BigInt)
+ * @param last Iterator past the last element
+ * @returns Sum of the range (0 if empty)
+ */
+template <typename Iter>
+inline BigInt BigInt::sum(ThreadPool &pool, Iter first, Iter last) {
+    ParallelScope scope{&pool, reduce_depth(pool)};
+    return sum(first, last);
+}
+
+
+/**
+ * @brief Parallel product of a range; subtrees and the sub-products of the largest multiplications run as tasks on pool
+ * @param pool Thread pool to run on
+ * @param first Iterator to the first element (BigInt or convertible to BigInt)
+ * @param last Iterator past the last element
+ * @returns Product of the range (1 if empty)
+ */
+template <typename Iter>
+inline BigInt BigInt::product(ThreadPool &pool, Iter first, Iter last) {
+    ParallelScope scope{&pool, reduce_depth(pool)};
+    return product(first, last);
+}
+
+
+/**
+ * @brief Balanced tree reduction of count elements; the halves of large subtrees run in parallel under an active ParallelScope.
+ * Halves computed as tasks are returned through the synchronized heap since they are freed on another thread
+ * @param first Iterator to the first element
+ * @param count Number of elements (> 0)
+ * @param op Associative operation (BigInt &&, const BigInt &) -> BigInt
+ * @returns Reduction of the elements
+ */
+template <typename Iter, typename Op>
+inline BigInt BigInt::reduce(Iter first, size_t count, Op op) {
+    if (count == 1) {
+        return BigInt(*first);
+    }
+    Iter mid = std::next(first, count / 2);
+    if (count == 2) {
+        return op(BigInt(*first), BigInt(*mid));
+    }
+    if (count >= parallel_reduce_thres && ParallelScope::pool()) {
+        BigInt halves[2] = {BigInt{std::pmr::new_delete_resource()}, BigInt{std::pmr::new_delete_resource()}};
+        parallel_for(2, [&](size_t i) {
+            halves[i] = i == 0 ? reduce(first, count / 2, op) : reduce(mid, count - count / 2, op);
+        });
+        return op(std::move(halves[0]), halves[1]);
+    }
+    BigInt low = reduce(first, count / 2, op);
+    return op(std::move(low), reduce(mid, count - count / 2, op));
+}
+
+
+/**
+ * @brief Parallel depth for reductions on pool: enough tree levels for about four subtrees per thread
+ * @param pool Thread pool to run on
+ * @returns ParallelScope depth
+ */
+inline size_t BigInt::reduce_depth(const ThreadPool &pool) {
+    size_t depth = 2;
+    for (size_t threads = pool.size() + 1; threads > 1; threads = (threads + 1) / 2) {
+        depth++;
+    }
+    return depth;
+}
+
+
+
+/**
+ * @brief Utility method applying a limb operation to the infinite two's complement representations of lhs and rhs (as Python does).
+ * Negative operands are complemented and incremented limb by limb as they are read, and a negative result is converted back the same
+ * way, so the operation is a single pass with no temporaries. Limb i is read from both operands before limb i of the result is
+ * written, so result may alias either operand; only its magnitude and sign are written (its thresholds are kept)
+ * @param result BigInt reference receiving the result
+ * @param lhs BigInt reference lhs operand
+ * @param rhs BigInt reference rhs operand
+ * @param op Bitwise limb operation (e.g. std::bit_and)
+ */
+template <typename Op>
+inline void BigInt::bitwise(BigInt &result, const BigInt &lhs, const BigInt &rhs, Op op) {
+    using limb_t = UBigInt::limb_t;
+    const LimbVector &x = lhs.magnitude.num;
+    const LimbVector &y = rhs.magnitude.num;
+    // sizes and signs are read before result, which may alias an operand, is resized or written
+    size_t x_size = x.size();
+    size_t y_size = y.size();
+    limb_t x_sign = -static_cast<limb_t>(lhs.neg);
+    limb_t y_sign = -static_cast<limb_t>(rhs.neg);
+    limb_t r_sign = op(x_sign, y_sign);
+    limb_t x_carry = lhs.neg;
+    limb_t y_carry = rhs.neg;
+    limb_t r_carry = r_sign != 0;
+    // above both operands the result limbs repeat r_sign; one extra limb holds the carry of a negative result's magnitude
+    size_t n = std::max(x_size, y_size) + (r_sign != 0);
+    LimbVector &r = result.magnitude.num;
+    r.resize(n, 0);
+    for (size_t i = 0; i < n; i++) {
+        limb_t xi = ((i < x_size ? x[i] : 0) ^ x_sign) + x_carry;
+        x_carry &= xi == 0;
+        limb_t yi = ((i < y_size ? y[i] : 0) ^ y_sign) + y_carry;
+        y_carry &= yi == 0;
+        limb_t ri = (op(xi, yi) ^ r_sign) + r_carry;
+        r_carry &= ri == 0;
+        r[i] = ri;
+    }
+    result.magnitude.trim();
+    result.neg = r_sign != 0 && !r.empty();
+}
+
+namespace std {
+/**
+ * @brief std::hash specialization so BigInt can key unordered containers
+ */
+template <>
+struct hash<BigInt> {
+    size_t operator()(const BigInt &x) const {return x.hash();}
+};
+}
+
 #endif
@@ -0,0 +1,204 @@
+#ifndef COMBINATORICS_H
+#define COMBINATORICS_H
+
+#include <cstdint>
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+#include "bigint.h"
+
+
+/**
+ * @brief Factorials, binomial coefficients and primorials from their prime factorizations.
+ * The primes come from a sieve and their exponents from Legendre's formula; the result is assembled bit plane by bit plane of the
+ * exponents (square, then multiply by the product of the primes whose exponent has that bit set), each plane being a balanced
+ * product tree (BigInt::product) of machine word chunks, so every large multiplication is balanced
+ */
+class Combinatorics {
+public:
+    inline static std::vector<std::uint64_t> primes(std::uint64_t n);
+    inline friend BigInt factorial(std::uint64_t n);
+    inline friend BigInt binomial(std::uint64_t n, std::uint64_t k);
+    inline friend BigInt primorial(std::uint64_t n);
+
+private:
+    inline static std::uint64_t legendre(std::uint64_t n, std::uint64_t p);
+    inline static BigInt chunked_product(const std::vector<std::uint64_t> &primes, const std::vector<std::uint64_t> &exponents, int bit);
+    inline static BigInt power_product(const std::vector<std::uint64_t> &primes, const std::vector<std::uint64_t> &exponents);
+    inline static BigInt falling_product(std::uint64_t n, std::uint64_t k);
+};
+
+
+/**
+ * @brief Sieve of Eratosthenes over the odd numbers
+ * @param n Upper bound (inclusive)
+ * @returns All primes <= n in increasing order
+ */
+inline std::vector<std::uint64_t> Combinatorics::primes(std::uint64_t n) {
+    std::vector<std::uint64_t> result;
+    if (n < 2) {
+        return result;
+    }
+    result.push_back(2);
+    // composite[i] marks 2i+1
+    std::vector<bool> composite((n + 1) / 2, false);
+    for (std::uint64_t i = 1; i < composite.size(); i++) {
+        if (composite[i]) {
+            continue;
+        }
+        std::uint64_t p = 2 * i + 1;
+        result.push_back(p);
+        for (std::uint64_t j = p * p / 2; j < composite.size(); j += p) {
+            composite[j] = true;
+        }
+    }
+    return result;
+}
+
+
+/**
+ * @brief Legendre's formula; exponent of the prime p in n!
+ * @param n Factorial argument
+ * @param p Prime
+ * @returns Sum of floor(n / p^i) for i >= 1
+ */
+inline std::uint64_t Combinatorics::legendre(std::uint64_t n, std::uint64_t p) {
+    std::uint64_t e = 0;
+    while (n >= p) {
+        n /= p;
+        e += n;
+    }
+    return e;
+}
+
+
+/**
+ * @brief Product of the primes whose exponent has the given bit set; primes are packed into machine words which are multiplied as a balanced tree
+ * @param primes Primes
+ * @param exponents Exponent of each prime
+ * @param bit Exponent bit to select on
+ * @returns Product of the selected primes
+ */
+inline BigInt Combinatorics::chunked_product(const std::vector<std::uint64_t> &primes, const std::vector<std::uint64_t> &exponents, int bit) {
+    std::vector<std::uint64_t> chunks;
+    std::uint64_t chunk = 1;
+    for (size_t i = 0; i < primes.size(); i++) {
+        if (!((exponents[i] >> bit) & 1)) {
+            continue;
+        }
+        if (chunk > std::numeric_limits<std::uint64_t>::max() / primes[i]) {
+            chunks.push_back(chunk);
+            chunk = 1;
+        }
+        chunk *= primes[i];
+    }
+    if (chunk > 1) {
+        chunks.push_back(chunk);
+    }
+    return BigInt::product(chunks.begin(), chunks.end());
+}
+
+
+/**
+ * @brief Product of primes[i]^exponents[i], assembled from the most significant exponent bit down by squaring
+ * @param primes Primes
+ * @param exponents Exponent of each prime
+ * @returns Product of the prime powers
+ */
+inline BigInt Combinatorics::power_product(const std::vector<std::uint64_t> &primes, const std::vector<std::uint64_t> &exponents) {
+    std::uint64_t max_exponent = 0;
+    for (std::uint64_t e : exponents) {
+        max_exponent |= e;
+    }
+    int top = -1;
+    while (max_exponent >> (top + 1)) {
+        top++;
+    }
+    BigInt result = 1;
+    for (int bit = top; bit >= 0; bit--) {
+        if (bit != top) {
+            result.square();
+        }
+        result *= chunked_product(primes, exponents, bit);
+    }
+    return result;
+}
+
+
+/**
+ * @brief Falling factorial n (n-1) ... (n-k+1); the factors are packed into machine words which are multiplied as a balanced tree
+ * @param n Largest factor
+ * @param k Number of factors (at most n)
+ * @returns Product of the k largest integers <= n
+ */
+inline BigInt Combinatorics::falling_product(std::uint64_t n, std::uint64_t k) {
+    std::vector<std::uint64_t> chunks;
+    std::uint64_t chunk = 1;
+    for (std::uint64_t i = 0; i < k; i++) {
+        std::uint64_t factor = n - i;
+        if (chunk > std::numeric_limits<std::uint64_t>::max() / factor) {
+            chunks.push_back(chunk);
+            chunk = 1;
+        }
+        chunk *= factor;
+    }
+    if (chunk > 1) {
+        chunks.push_back(chunk);
+    }
+    return BigInt::product(chunks.begin(), chunks.end());
+}
+
+
+/**
+ * @brief Factorial n! from its prime factorization
+ * @param n Argument
+ * @returns n!
+ */
+inline BigInt factorial(std::uint64_t n) {
+    std::vector<std::uint64_t> primes = Combinatorics::primes(n);
+    std::vector<std::uint64_t> exponents(primes.size());
+    for (size_t i = 0; i < primes.size(); i++) {
+        exponents[i] = Combinatorics::legendre(n, primes[i]);
+    }
+    return Combinatorics::power_product(primes, exponents);
+}
+
+
+/**
+ * @brief Binomial coefficient n choose k from its prime factorization (exponents by Legendre's formula, n! / (k! (n-k)!)).
+ * The sieve runs up to n, so when k (after k = min(k, n - k)) is below n / 64 the coefficient is instead the falling factorial
+ * n ... (n-k+1) divided exactly by k!, whose work and memory only depend on k and the size of n
+ * @param n Size of the set
+ * @param k Size of the subsets
+ * @returns Number of k-subsets of an n-set (0 if k > n)
+ */
+inline BigInt binomial(std::uint64_t n, std::uint64_t k) {
+    if (k > n) {
+        return 0;
+    }
+    k = std::min(k, n - k);
+    if (k < n / 64) {
+        return Combinatorics::falling_product(n, k) / factorial(k);
+    }
+    std::vector<std::uint64_t> primes = Combinatorics::primes(n);
+    std::vector<std::uint64_t> exponents(primes.size());
+    for (size_t i = 0; i < primes.size(); i++) {
+        std::uint64_t p = primes[i];
+        exponents[i] = Combinatorics::legendre(n, p) - Combinatorics::legendre(k, p) - Combinatorics::legendre(n - k, p);
+    }
+    return Combinatorics::power_product(primes, exponents);
+}
+
+
+/**
+ * @brief Primorial n#, the product of all primes <= n
+ * @param n Upper bound (inclusive)
+ * @returns Product of the primes <= n (1 if n < 2)
+ */
+inline BigInt primorial(std::uint64_t n) {
+    std::vector<std::uint64_t> primes = Combinatorics::primes(n);
+    return Combinatorics::chunked_product(primes, std::vector<std::uint64_t>(primes.size(), 1), 0);
+}
+
+#endif
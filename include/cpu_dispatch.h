@@ -0,0 +1,285 @@
+#ifndef CPU_DISPATCH_H
+#define CPU_DISPATCH_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <atomic>
+
+#include "limb_simd.h"
+
+#ifdef LIMB_SIMD_X86
+#include <cpuid.h>
+#endif
+
+
+/**
+ * @brief Table of the limb kernels the arithmetic runs on (see CpuDispatch)
+ */
+struct LimbKernels {
+    using limb_t = std::uint64_t;
+    limb_t (*add_n)(limb_t *out, const limb_t *x, const limb_t *y, size_t n);
+    limb_t (*sub_n)(limb_t *out, const limb_t *x, const limb_t *y, size_t n);
+    limb_t (*addmul_1)(limb_t *out, const limb_t *x, size_t n, limb_t y);
+    limb_t (*submul_1)(limb_t *out, const limb_t *x, size_t n, limb_t y);
+};
+
+
+/**
+ * @brief Runtime selection of the limb kernels by CPU features, so one binary runs the fastest code each machine supports.
+ * Levels are cumulative: bmi2 adds the mulx/adcx/adox multiply rows, avx2 and avx512 the vector add/sub kernels. The level
+ * is detected with cpuid on first use unless the environment variable BIGINTCPP_KERNELS names one (generic, bmi2, avx2, avx512),
+ * and can be changed with set_level(), e.g. to test every path on one machine. A level only enables kernels the CPU
+ * actually supports, so forcing one the machine lacks falls back to the best available below it. Callers compare a table entry
+ * against the public portable kernel and call that directly when it is selected, so the generic level keeps the inlined loops
+ */
+class CpuDispatch {
+public:
+    using limb_t = LimbKernels::limb_t;
+    enum class Level {generic, bmi2, avx2, avx512};
+    inline static const LimbKernels& kernels();
+    inline static Level level();
+    inline static void set_level(Level level);
+    inline static Level supported();
+    inline static const char* name(Level level);
+    inline static limb_t add_n_generic(limb_t *out, const limb_t *x, const limb_t *y, size_t n);
+    inline static limb_t sub_n_generic(limb_t *out, const limb_t *x, const limb_t *y, size_t n);
+    inline static limb_t addmul_1_generic(limb_t *out, const limb_t *x, size_t n, limb_t y);
+    inline static limb_t submul_1_generic(limb_t *out, const limb_t *x, size_t n, limb_t y);
+
+private:
+    struct Features {
+        bool bmi2_adx = false;
+        bool avx2 = false;
+        bool avx512 = false;
+    };
+    inline static const Features& features();
+    inline static const LimbKernels& table(Level level);
+    inline static std::atomic<Level>& current();
+};
+
+
+/**
+ * @brief Kernels of the active level
+ * @returns Reference to the kernel table
+ */
+inline const LimbKernels& CpuDispatch::kernels() {
+    return table(current().load(std::memory_order_relaxed));
+}
+
+
+/**
+ * @brief Active level
+ * @returns Level the kernels are selected for
+ */
+inline CpuDispatch::Level CpuDispatch::level() {
+    return current().load(std::memory_order_relaxed);
+}
+
+
+/**
+ * @brief Selects the kernels of a level for all threads; must not race with arithmetic in progress
+ * @param level Level to select (kernels the CPU lacks fall back to lower levels)
+ */
+inline void CpuDispatch::set_level(Level level) {
+    current().store(level, std::memory_order_relaxed);
+}
+
+
+/**
+ * @brief Highest level the CPU supports
+ * @returns Detected level
+ */
+inline CpuDispatch::Level CpuDispatch::supported() {
+    const Features &f = features();
+    if (f.avx512) {
+        return Level::avx512;
+    }
+    if (f.avx2) {
+        return Level::avx2;
+    }
+    return f.bmi2_adx ? Level::bmi2 : Level::generic;
+}
+
+
+/**
+ * @brief Name of a level as accepted in BIGINTCPP_KERNELS
+ * @param level Level
+ * @returns Level name
+ */
+inline const char* CpuDispatch::name(Level level) {
+    static const char *const names[] = {"generic", "bmi2", "avx2", "avx512"};
+    return names[static_cast<int>(level)];
+}
+
+
+/**
+ * @brief CPU features queried once with cpuid; AVX state must also be enabled by the OS (xgetbv)
+ * @returns Reference to the detected features
+ */
+inline const CpuDispatch::Features& CpuDispatch::features() {
+    static const Features detected = [] {
+        Features f;
+#ifdef LIMB_SIMD_X86
+        unsigned eax, ebx, ecx, edx;
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+            return f;
+        }
+        bool osxsave = (ecx >> 27) & 1;
+        unsigned long long xcr0 = 0;
+        if (osxsave) {
+            unsigned lo, hi;
+            __asm__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+            xcr0 = (static_cast<unsigned long long>(hi) << 32) | lo;
+        }
+        if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+            return f;
+        }
+        bool ymm = (xcr0 & 0x6) == 0x6;
+        bool zmm = ymm && (xcr0 & 0xE0) == 0xE0;
+        f.bmi2_adx = ((ebx >> 8) & 1) && ((ebx >> 19) & 1);
+        f.avx2 = ymm && ((ebx >> 5) & 1);
+        f.avx512 = zmm && ((ebx >> 16) & 1);
+#endif
+        return f;
+    }();
+    return detected;
+}
+
+
+/**
+ * @brief Kernel table of a level, built once per level from the detected features
+ * @param level Level
+ * @returns Reference to the kernel table
+ */
+inline const LimbKernels& CpuDispatch::table(Level level) {
+    static const auto tables = [] {
+        struct Tables {
+            LimbKernels levels[4];
+        } result;
+        for (int i = 0; i < 4; i++) {
+            LimbKernels k{add_n_generic, sub_n_generic, addmul_1_generic, submul_1_generic};
+#ifdef LIMB_SIMD_X86
+            const Features &f = features();
+            if (i >= static_cast<int>(Level::bmi2) && f.bmi2_adx) {
+                k.addmul_1 = LimbSimd::addmul_1_adx;
+                k.submul_1 = LimbSimd::submul_1_adx;
+            }
+            if (i >= static_cast<int>(Level::avx2) && f.avx2) {
+                k.add_n = LimbSimd::add_n_avx2;
+                k.sub_n = LimbSimd::sub_n_avx2;
+            }
+            if (i >= static_cast<int>(Level::avx512) && f.avx512) {
+                k.add_n = LimbSimd::add_n_avx512;
+                k.sub_n = LimbSimd::sub_n_avx512;
+            }
+#endif
+            result.levels[i] = k;
+        }
+        return result;
+    }();
+    return tables.levels[static_cast<int>(level)];
+}
+
+
+/**
+ * @brief Active level, initialized from BIGINTCPP_KERNELS or else the detected level
+ * @returns Reference to the active level
+ */
+inline std::atomic<CpuDispatch::Level>& CpuDispatch::current() {
+    static std::atomic<Level> active{[] {
+        if (const char *env = std::getenv("BIGINTCPP_KERNELS")) {
+            for (Level level : {Level::generic, Level::bmi2, Level::avx2, Level::avx512}) {
+                if (std::strcmp(env, name(level)) == 0) {
+                    return level;
+                }
+            }
+        }
+        return supported();
+    }()};
+    return active;
+}
+
+
+/**
+ * @brief Portable kernel out = x + y over n limbs; out may alias x or y
+ * @param out Sum limbs
+ * @param x Left hand limbs
+ * @param y Right hand limbs
+ * @param n Number of limbs
+ * @returns Carry out of the top limb (0 or 1)
+ */
+inline CpuDispatch::limb_t CpuDispatch::add_n_generic(limb_t *out, const limb_t *x, const limb_t *y, size_t n) {
+    limb_t carry = 0;
+    for (size_t i = 0; i < n; i++) {
+        unsigned __int128 sum = static_cast<unsigned __int128>(x[i]) + y[i] + carry;
+        out[i] = static_cast<limb_t>(sum);
+        carry = static_cast<limb_t>(sum >> 64);
+    }
+    return carry;
+}
+
+
+/**
+ * @brief Portable kernel out = x - y over n limbs; out may alias x or y
+ * @param out Difference limbs
+ * @param x Left hand limbs
+ * @param y Right hand limbs
+ * @param n Number of limbs
+ * @returns Borrow out of the top limb (0 or 1)
+ */
+inline CpuDispatch::limb_t CpuDispatch::sub_n_generic(limb_t *out, const limb_t *x, const limb_t *y, size_t n) {
+    limb_t borrow = 0;
+    for (size_t i = 0; i < n; i++) {
+        limb_t column_diff = x[i] - y[i];
+        limb_t next_borrow = x[i] < y[i];
+        next_borrow |= column_diff < borrow;
+        out[i] = column_diff - borrow;
+        borrow = next_borrow;
+    }
+    return borrow;
+}
+
+
+/**
+ * @brief Portable row kernel out += x * y over n limbs
+ * @param out Accumulator limbs (must not overlap x)
+ * @param x Multiplicand limbs
+ * @param n Number of limbs
+ * @param y Single limb multiplier
+ * @returns Carry limb out of the top of out
+ */
+inline CpuDispatch::limb_t CpuDispatch::addmul_1_generic(limb_t *out, const limb_t *x, size_t n, limb_t y) {
+    limb_t carry = 0;
+    for (size_t i = 0; i < n; i++) {
+        unsigned __int128 prod = static_cast<unsigned __int128>(x[i]) * y + out[i] + carry;
+        out[i] = static_cast<limb_t>(prod);
+        carry = static_cast<limb_t>(prod >> 64);
+    }
+    return carry;
+}
+
+
+/**
+ * @brief Portable row kernel out -= x * y over n limbs
+ * @param out Accumulator limbs (must not overlap x)
+ * @param x Multiplicand limbs
+ * @param n Number of limbs
+ * @param y Single limb multiplier
+ * @returns Borrow limb to subtract from the limb above out
+ */
+inline CpuDispatch::limb_t CpuDispatch::submul_1_generic(limb_t *out, const limb_t *x, size_t n, limb_t y) {
+    limb_t carry = 0;
+    for (size_t i = 0; i < n; i++) {
+        unsigned __int128 prod = static_cast<unsigned __int128>(x[i]) * y + carry;
+        limb_t low = static_cast<limb_t>(prod);
+        carry = static_cast<limb_t>(prod >> 64);
+        limb_t cur = out[i];
+        out[i] = cur - low;
+        carry += cur < low;
+    }
+    return carry;
+}
+
+#endif
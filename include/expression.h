@@ -0,0 +1,445 @@
+#ifndef EXPRESSION_H
+#define EXPRESSION_H
+
+#include <stdexcept>
+#include <utility>
+
+#include "bigint.h"
+
+
+/**
+ * @brief Opt-in expression templates for UBigInt/BigInt.
+ * Wrapping an operand with lazy() makes +, - and * build lightweight expression nodes instead of values; the whole
+ * expression is then evaluated term by term into a single accumulator, with every product of two operands added
+ * straight into the accumulator's limbs (see UBigInt::signed_add_product). With assign() or +=/-= that accumulator is
+ * the destination itself, so e.g. assign(r, lazy(a)*b + lazy(c)*d - e) creates no temporaries at all.
+ * Nodes only hold references to their operands: evaluate an expression within the statement that builds it.
+ */
+
+
+/**
+ * @brief Signed magnitude an expression is accumulated into
+ */
+struct LazyAccumulator {
+    UBigInt &magnitude;
+    bool &neg;
+    const MulThresholds &thres;
+    inline void add(const UBigInt &x, bool x_neg);
+    inline void add_product(const UBigInt &lhs, const UBigInt &rhs, bool product_neg);
+};
+
+
+/**
+ * @brief Adapts UBigInt and BigInt to the expression templates (sign/magnitude access and accumulation into a destination)
+ */
+template <class T>
+struct LazyTraits;
+
+
+template <>
+struct LazyTraits<UBigInt> {
+    static const UBigInt& magnitude(const UBigInt &x) {return x;}
+    static bool negative(const UBigInt &) {return false;}
+    static void clear(UBigInt &x) {x = 0;}
+    template <class E>
+    inline static void accumulate(UBigInt &dest, const E &expr, bool subtract);
+};
+
+
+template <>
+struct LazyTraits<BigInt> {
+    static const UBigInt& magnitude(const BigInt &x) {return x.magnitude;}
+    static bool negative(const BigInt &x) {return x.neg;}
+    static void clear(BigInt &x) {x.magnitude = 0; x.neg = false;}
+    template <class E>
+    inline static void accumulate(BigInt &dest, const E &expr, bool subtract);
+};
+
+
+/**
+ * @brief CRTP base of all expression nodes
+ */
+template <class T, class E>
+class LazyExpr {
+public:
+    using value_type = T;
+    const E& self() const {return static_cast<const E&>(*this);}
+    inline operator T() const;
+};
+
+
+/**
+ * @brief Leaf node referring to an existing value
+ */
+template <class T>
+class LazyRef : public LazyExpr<T, LazyRef<T>> {
+public:
+    explicit LazyRef(const T &value) : value{value} {}
+    void accumulate(LazyAccumulator &acc, bool subtract) const {
+        acc.add(LazyTraits<T>::magnitude(value), LazyTraits<T>::negative(value) != subtract);
+    }
+    const T& operand(T &) const {return value;}
+    bool references(const T &x) const {return &value == &x;}
+
+private:
+    const T &value;
+};
+
+
+/**
+ * @brief Product node; accumulates as a fused multiply-add, materializing only factors that are themselves expressions
+ */
+template <class T, class L, class R>
+class LazyProduct : public LazyExpr<T, LazyProduct<T, L, R>> {
+public:
+    LazyProduct(const L &lhs, const R &rhs) : lhs{lhs}, rhs{rhs} {}
+    void accumulate(LazyAccumulator &acc, bool subtract) const {
+        T lhs_storage, rhs_storage;
+        const T &a = lhs.operand(lhs_storage);
+        const T &b = rhs.operand(rhs_storage);
+        bool product_neg = LazyTraits<T>::negative(a) != LazyTraits<T>::negative(b);
+        acc.add_product(LazyTraits<T>::magnitude(a), LazyTraits<T>::magnitude(b), product_neg != subtract);
+    }
+    const T& operand(T &storage) const {
+        storage = *this;
+        return storage;
+    }
+    bool references(const T &x) const {return lhs.references(x) || rhs.references(x);}
+
+private:
+    L lhs;
+    R rhs;
+};
+
+
+/**
+ * @brief Sum (or difference when Subtract) node; accumulates both sides in turn
+ */
+template <class T, class L, class R, bool Subtract>
+class LazySum : public LazyExpr<T, LazySum<T, L, R, Subtract>> {
+public:
+    LazySum(const L &lhs, const R &rhs) : lhs{lhs}, rhs{rhs} {}
+    void accumulate(LazyAccumulator &acc, bool subtract) const {
+        lhs.accumulate(acc, subtract);
+        rhs.accumulate(acc, subtract != Subtract);
+    }
+    const T& operand(T &storage) const {
+        storage = *this;
+        return storage;
+    }
+    bool references(const T &x) const {return lhs.references(x) || rhs.references(x);}
+
+private:
+    L lhs;
+    R rhs;
+};
+
+
+/**
+ * @brief Accumulator addition of a signed value
+ * @param x Magnitude to add
+ * @param x_neg Sign of x
+ */
+inline void LazyAccumulator::add(const UBigInt &x, bool x_neg) {
+    UBigInt::signed_add(magnitude, neg, x, x_neg);
+}
+
+
+/**
+ * @brief Accumulator fused addition of a signed product
+ * @param lhs Left hand factor magnitude
+ * @param rhs Right hand factor magnitude
+ * @param product_neg Sign of the product
+ */
+inline void LazyAccumulator::add_product(const UBigInt &lhs, const UBigInt &rhs, bool product_neg) {
+    UBigInt::signed_add_product(magnitude, neg, lhs, rhs, product_neg, thres);
+}
+
+
+/**
+ * @brief Accumulates an expression into a UBigInt; intermediate sums may go negative, the final value may not
+ * @param dest UBigInt accumulated into (must not be referenced by expr); left unchanged if the result would be negative
+ * @param expr Expression to add
+ * @param subtract Subtract expr instead
+ * @throws std::runtime_error if the result would be negative
+ */
+template <class E>
+inline void LazyTraits<UBigInt>::accumulate(UBigInt &dest, const E &expr, bool subtract) {
+    bool neg = false;
+    MulThresholds thres;
+    LazyAccumulator acc{dest, neg, thres};
+    expr.accumulate(acc, subtract);
+    if (neg) {
+        // undo in place: accumulating the expression with the opposite sign restores dest exactly
+        expr.accumulate(acc, !subtract);
+        throw std::runtime_error("Negative value in UBigInt (unsigned) subtraction.");
+    }
+}
+
+
+/**
+ * @brief Accumulates an expression into a BigInt using the destination's multiplication thresholds
+ * @param dest BigInt accumulated into (must not be referenced by expr)
+ * @param expr Expression to add
+ * @param subtract Subtract expr instead
+ */
+template <class E>
+inline void LazyTraits<BigInt>::accumulate(BigInt &dest, const E &expr, bool subtract) {
+    LazyAccumulator acc{dest.magnitude, dest.neg, dest.mul_thres};
+    expr.accumulate(acc, subtract);
+}
+
+
+/**
+ * @brief Evaluates the expression into a new value
+ * @returns Copy of new instance
+ */
+template <class T, class E>
+inline LazyExpr<T, E>::operator T() const {
+    T result;
+    LazyTraits<T>::accumulate(result, self(), false);
+    return result;
+}
+
+
+/**
+ * @brief Starts an expression; arithmetic on the returned node is evaluated lazily
+ * @param value UBigInt or BigInt reference (must outlive the evaluation)
+ * @returns Leaf expression node
+ */
+template <class T>
+inline LazyRef<T> lazy(const T &value) {
+    return LazyRef<T>(value);
+}
+
+
+/**
+ * @brief Evaluates expr straight into dest, reusing dest's storage; falls back to a temporary when expr reads dest
+ * @param dest UBigInt or BigInt reference assigned to
+ * @param expr Expression to evaluate
+ * @returns Reference to dest
+ */
+template <class T, class E>
+inline T& assign(T &dest, const LazyExpr<T, E> &expr) {
+    if (expr.self().references(dest)) {
+        dest = static_cast<T>(expr);
+        return dest;
+    }
+    LazyTraits<T>::clear(dest);
+    LazyTraits<T>::accumulate(dest, expr.self(), false);
+    return dest;
+}
+
+
+/**
+ * @brief Adds expr into dest's storage, e.g. acc += lazy(a) * b as a fused multiply-add
+ * @param dest UBigInt or BigInt reference added to
+ * @param expr Expression to add
+ * @returns Reference to dest
+ */
+template <class T, class E>
+inline T& operator+=(T &dest, const LazyExpr<T, E> &expr) {
+    if (expr.self().references(dest)) {
+        return dest += static_cast<T>(expr);
+    }
+    LazyTraits<T>::accumulate(dest, expr.self(), false);
+    return dest;
+}
+
+
+/**
+ * @brief Subtracts expr from dest in dest's storage
+ * @param dest UBigInt or BigInt reference subtracted from
+ * @param expr Expression to subtract
+ * @returns Reference to dest
+ */
+template <class T, class E>
+inline T& operator-=(T &dest, const LazyExpr<T, E> &expr) {
+    if (expr.self().references(dest)) {
+        return dest -= static_cast<T>(expr);
+    }
+    LazyTraits<T>::accumulate(dest, expr.self(), true);
+    return dest;
+}
+
+
+/**
+ * @brief Lazy product of two expressions
+ * @param lhs Expression lhs factor
+ * @param rhs Expression rhs factor
+ * @returns Product node
+ */
+template <class T, class L, class R>
+inline LazyProduct<T, L, R> operator*(const LazyExpr<T, L> &lhs, const LazyExpr<T, R> &rhs) {
+    return {lhs.self(), rhs.self()};
+}
+
+
+/**
+ * @brief Lazy product of an expression and a value
+ * @param lhs Expression lhs factor
+ * @param rhs Value rhs factor
+ * @returns Product node
+ */
+template <class T, class L>
+inline LazyProduct<T, L, LazyRef<T>> operator*(const LazyExpr<T, L> &lhs, const typename LazyExpr<T, L>::value_type &rhs) {
+    return {lhs.self(), LazyRef<T>(rhs)};
+}
+
+
+/**
+ * @brief Lazy product of an expression and a temporary value (which lives until the end of the full expression)
+ * @param lhs Expression lhs factor
+ * @param rhs Temporary value rhs factor
+ * @returns Product node
+ */
+template <class T, class L>
+inline LazyProduct<T, L, LazyRef<T>> operator*(const LazyExpr<T, L> &lhs, typename LazyExpr<T, L>::value_type &&rhs) {
+    return {lhs.self(), LazyRef<T>(rhs)};
+}
+
+
+/**
+ * @brief Lazy product of a value and an expression
+ * @param lhs Value lhs factor
+ * @param rhs Expression rhs factor
+ * @returns Product node
+ */
+template <class T, class R>
+inline LazyProduct<T, LazyRef<T>, R> operator*(const typename LazyExpr<T, R>::value_type &lhs, const LazyExpr<T, R> &rhs) {
+    return {LazyRef<T>(lhs), rhs.self()};
+}
+
+
+/**
+ * @brief Lazy product of a temporary value (which lives until the end of the full expression) and an expression
+ * @param lhs Temporary value lhs factor
+ * @param rhs Expression rhs factor
+ * @returns Product node
+ */
+template <class T, class R>
+inline LazyProduct<T, LazyRef<T>, R> operator*(typename LazyExpr<T, R>::value_type &&lhs, const LazyExpr<T, R> &rhs) {
+    return {LazyRef<T>(lhs), rhs.self()};
+}
+
+
+/**
+ * @brief Lazy sum of two expressions
+ * @param lhs Expression lhs term
+ * @param rhs Expression rhs term
+ * @returns Sum node
+ */
+template <class T, class L, class R>
+inline LazySum<T, L, R, false> operator+(const LazyExpr<T, L> &lhs, const LazyExpr<T, R> &rhs) {
+    return {lhs.self(), rhs.self()};
+}
+
+
+/**
+ * @brief Lazy sum of an expression and a value
+ * @param lhs Expression lhs term
+ * @param rhs Value rhs term
+ * @returns Sum node
+ */
+template <class T, class L>
+inline LazySum<T, L, LazyRef<T>, false> operator+(const LazyExpr<T, L> &lhs, const typename LazyExpr<T, L>::value_type &rhs) {
+    return {lhs.self(), LazyRef<T>(rhs)};
+}
+
+
+/**
+ * @brief Lazy sum of an expression and a temporary value (which lives until the end of the full expression)
+ * @param lhs Expression lhs term
+ * @param rhs Temporary value rhs term
+ * @returns Sum node
+ */
+template <class T, class L>
+inline LazySum<T, L, LazyRef<T>, false> operator+(const LazyExpr<T, L> &lhs, typename LazyExpr<T, L>::value_type &&rhs) {
+    return {lhs.self(), LazyRef<T>(rhs)};
+}
+
+
+/**
+ * @brief Lazy sum of a value and an expression
+ * @param lhs Value lhs term
+ * @param rhs Expression rhs term
+ * @returns Sum node
+ */
+template <class T, class R>
+inline LazySum<T, LazyRef<T>, R, false> operator+(const typename LazyExpr<T, R>::value_type &lhs, const LazyExpr<T, R> &rhs) {
+    return {LazyRef<T>(lhs), rhs.self()};
+}
+
+
+/**
+ * @brief Lazy sum of a temporary value (which lives until the end of the full expression) and an expression
+ * @param lhs Temporary value lhs term
+ * @param rhs Expression rhs term
+ * @returns Sum node
+ */
+template <class T, class R>
+inline LazySum<T, LazyRef<T>, R, false> operator+(typename LazyExpr<T, R>::value_type &&lhs, const LazyExpr<T, R> &rhs) {
+    return {LazyRef<T>(lhs), rhs.self()};
+}
+
+
+/**
+ * @brief Lazy difference of two expressions
+ * @param lhs Expression minuend
+ * @param rhs Expression subtrahend
+ * @returns Difference node
+ */
+template <class T, class L, class R>
+inline LazySum<T, L, R, true> operator-(const LazyExpr<T, L> &lhs, const LazyExpr<T, R> &rhs) {
+    return {lhs.self(), rhs.self()};
+}
+
+
+/**
+ * @brief Lazy difference of an expression and a value
+ * @param lhs Expression minuend
+ * @param rhs Value subtrahend
+ * @returns Difference node
+ */
+template <class T, class L>
+inline LazySum<T, L, LazyRef<T>, true> operator-(const LazyExpr<T, L> &lhs, const typename LazyExpr<T, L>::value_type &rhs) {
+    return {lhs.self(), LazyRef<T>(rhs)};
+}
+
+
+/**
+ * @brief Lazy difference of an expression and a temporary value (which lives until the end of the full expression)
+ * @param lhs Expression minuend
+ * @param rhs Temporary value subtrahend
+ * @returns Difference node
+ */
+template <class T, class L>
+inline LazySum<T, L, LazyRef<T>, true> operator-(const LazyExpr<T, L> &lhs, typename LazyExpr<T, L>::value_type &&rhs) {
+    return {lhs.self(), LazyRef<T>(rhs)};
+}
+
+
+/**
+ * @brief Lazy difference of a value and an expression
+ * @param lhs Value minuend
+ * @param rhs Expression subtrahend
+ * @returns Difference node
+ */
+template <class T, class R>
+inline LazySum<T, LazyRef<T>, R, true> operator-(const typename LazyExpr<T, R>::value_type &lhs, const LazyExpr<T, R> &rhs) {
+    return {LazyRef<T>(lhs), rhs.self()};
+}
+
+
+/**
+ * @brief Lazy difference of a temporary value (which lives until the end of the full expression) and an expression
+ * @param lhs Temporary value minuend
+ * @param rhs Expression subtrahend
+ * @returns Difference node
+ */
+template <class T, class R>
+inline LazySum<T, LazyRef<T>, R, true> operator-(typename LazyExpr<T, R>::value_type &&lhs, const LazyExpr<T, R> &rhs) {
+    return {LazyRef<T>(lhs), rhs.self()};
+}
+
+#endif
@@ -0,0 +1,313 @@
+#ifndef LIMB_SIMD_H
+#define LIMB_SIMD_H
+
+#include <cstdint>
+#include <cstddef>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define LIMB_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+
+/**
+ * @brief Instruction set specific limb kernels (least significant limb first) for x86-64.
+ * add_n/sub_n: each vector of 4 (AVX2) or 8 (AVX-512) limbs is added lane-wise; the lanes that generate a carry (sum < operand)
+ * and the lanes that propagate one (sum all ones) form two bit masks, and the carries entering every lane follow from a single
+ * integer addition of those masks (carry-lookahead), so the only serial dependency is one scalar add per vector.
+ * addmul_1/submul_1: mulx leaves the flags alone, so the carries between product halves (adox, overflow flag) and into the
+ * accumulator (adcx, carry flag) run as two independent chains.
+ * Out may alias either operand of add_n/sub_n. The kernels are compiled for their instruction set regardless of the build flags;
+ * callers must only use them on CPUs that support it (see CpuDispatch)
+ */
+class LimbSimd {
+public:
+    using limb_t = std::uint64_t;
+#ifdef LIMB_SIMD_X86
+    inline static limb_t add_n_avx2(limb_t *out, const limb_t *x, const limb_t *y, size_t n);
+    inline static limb_t sub_n_avx2(limb_t *out, const limb_t *x, const limb_t *y, size_t n);
+    inline static limb_t add_n_avx512(limb_t *out, const limb_t *x, const limb_t *y, size_t n);
+    inline static limb_t sub_n_avx512(limb_t *out, const limb_t *x, const limb_t *y, size_t n);
+    inline static limb_t addmul_1_adx(limb_t *out, const limb_t *x, size_t n, limb_t y);
+    inline static limb_t submul_1_adx(limb_t *out, const limb_t *x, size_t n, limb_t y);
+#endif
+
+private:
+    inline static limb_t add_tail(limb_t *out, const limb_t *x, const limb_t *y, size_t n, limb_t carry);
+    inline static limb_t sub_tail(limb_t *out, const limb_t *x, const limb_t *y, size_t n, limb_t borrow);
+};
+
+
+/**
+ * @brief Scalar remainder of an addition
+ * @param out Sum limbs
+ * @param x Left hand limbs
+ * @param y Right hand limbs
+ * @param n Number of limbs
+ * @param carry Incoming carry (0 or 1)
+ * @returns Carry out of the top limb
+ */
+inline LimbSimd::limb_t LimbSimd::add_tail(limb_t *out, const limb_t *x, const limb_t *y, size_t n, limb_t carry) {
+    for (size_t i = 0; i < n; i++) {
+        limb_t sum = x[i] + carry;
+        carry = sum < carry;
+        out[i] = sum + y[i];
+        carry += out[i] < sum;
+    }
+    return carry;
+}
+
+
+/**
+ * @brief Scalar remainder of a subtraction
+ * @param out Difference limbs
+ * @param x Left hand limbs
+ * @param y Right hand limbs
+ * @param n Number of limbs
+ * @param borrow Incoming borrow (0 or 1)
+ * @returns Borrow out of the top limb
+ */
+inline LimbSimd::limb_t LimbSimd::sub_tail(limb_t *out, const limb_t *x, const limb_t *y, size_t n, limb_t borrow) {
+    for (size_t i = 0; i < n; i++) {
+        limb_t cur = x[i], sub = y[i];
+        limb_t diff = cur - sub;
+        limb_t next = (cur < sub) | (diff < borrow);
+        out[i] = diff - borrow;
+        borrow = next;
+    }
+    return borrow;
+}
+
+
+#ifdef LIMB_SIMD_X86
+/**
+ * @brief AVX2 kernel out = x + y over n limbs
+ * @param out Sum limbs
+ * @param x Left hand limbs
+ * @param y Right hand limbs
+ * @param n Number of limbs
+ * @returns Carry out of the top limb (0 or 1)
+ */
+__attribute__((target("avx2")))
+inline LimbSimd::limb_t LimbSimd::add_n_avx2(limb_t *out, const limb_t *x, const limb_t *y, size_t n) {
+    const __m256i sign = _mm256_set1_epi64x(static_cast<long long>(1ull << 63));
+    const __m256i ones = _mm256_set1_epi64x(-1);
+    const __m256i lanes = _mm256_setr_epi64x(0, 1, 2, 3);
+    const __m256i one = _mm256_set1_epi64x(1);
+    unsigned carry = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i));
+        __m256i sum = _mm256_add_epi64(a, b);
+        // AVX2 only compares signed: flip the sign bits for the unsigned sum < a
+        __m256i generate = _mm256_cmpgt_epi64(_mm256_xor_si256(a, sign), _mm256_xor_si256(sum, sign));
+        unsigned g = _mm256_movemask_pd(_mm256_castsi256_pd(generate));
+        unsigned p = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(sum, ones)));
+        unsigned m = ((g << 1) | carry) + p;
+        unsigned c = (m ^ p) & 0xF;
+        carry = m >> 4;
+        __m256i carries = _mm256_and_si256(_mm256_srlv_epi64(_mm256_set1_epi64x(c), lanes), one);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_add_epi64(sum, carries));
+    }
+    return add_tail(out + i, x + i, y + i, n - i, carry);
+}
+
+
+/**
+ * @brief AVX2 kernel out = x - y over n limbs
+ * @param out Difference limbs
+ * @param x Left hand limbs
+ * @param y Right hand limbs
+ * @param n Number of limbs
+ * @returns Borrow out of the top limb (0 or 1)
+ */
+__attribute__((target("avx2")))
+inline LimbSimd::limb_t LimbSimd::sub_n_avx2(limb_t *out, const limb_t *x, const limb_t *y, size_t n) {
+    const __m256i sign = _mm256_set1_epi64x(static_cast<long long>(1ull << 63));
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i lanes = _mm256_setr_epi64x(0, 1, 2, 3);
+    const __m256i one = _mm256_set1_epi64x(1);
+    unsigned borrow = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i));
+        __m256i diff = _mm256_sub_epi64(a, b);
+        // a lane generates a borrow if a < b and passes an incoming one on if its difference is zero
+        __m256i generate = _mm256_cmpgt_epi64(_mm256_xor_si256(b, sign), _mm256_xor_si256(a, sign));
+        unsigned g = _mm256_movemask_pd(_mm256_castsi256_pd(generate));
+        unsigned p = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(diff, zero)));
+        unsigned m = ((g << 1) | borrow) + p;
+        unsigned c = (m ^ p) & 0xF;
+        borrow = m >> 4;
+        __m256i borrows = _mm256_and_si256(_mm256_srlv_epi64(_mm256_set1_epi64x(c), lanes), one);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_sub_epi64(diff, borrows));
+    }
+    return sub_tail(out + i, x + i, y + i, n - i, borrow);
+}
+
+
+/**
+ * @brief AVX-512 kernel out = x + y over n limbs
+ * @param out Sum limbs
+ * @param x Left hand limbs
+ * @param y Right hand limbs
+ * @param n Number of limbs
+ * @returns Carry out of the top limb (0 or 1)
+ */
+__attribute__((target("avx512f")))
+inline LimbSimd::limb_t LimbSimd::add_n_avx512(limb_t *out, const limb_t *x, const limb_t *y, size_t n) {
+    const __m512i ones = _mm512_set1_epi64(-1);
+    unsigned carry = 0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512i a = _mm512_loadu_si512(x + i);
+        __m512i sum = _mm512_add_epi64(a, _mm512_loadu_si512(y + i));
+        unsigned g = _mm512_cmplt_epu64_mask(sum, a);
+        unsigned p = _mm512_cmpeq_epu64_mask(sum, ones);
+        unsigned m = ((g << 1) | carry) + p;
+        carry = m >> 8;
+        _mm512_storeu_si512(out + i, _mm512_mask_sub_epi64(sum, static_cast<__mmask8>(m ^ p), sum, ones));
+    }
+    return add_tail(out + i, x + i, y + i, n - i, carry);
+}
+
+
+/**
+ * @brief AVX-512 kernel out = x - y over n limbs
+ * @param out Difference limbs
+ * @param x Left hand limbs
+ * @param y Right hand limbs
+ * @param n Number of limbs
+ * @returns Borrow out of the top limb (0 or 1)
+ */
+__attribute__((target("avx512f")))
+inline LimbSimd::limb_t LimbSimd::sub_n_avx512(limb_t *out, const limb_t *x, const limb_t *y, size_t n) {
+    const __m512i ones = _mm512_set1_epi64(-1);
+    const __m512i zero = _mm512_setzero_si512();
+    unsigned borrow = 0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512i a = _mm512_loadu_si512(x + i);
+        __m512i b = _mm512_loadu_si512(y + i);
+        __m512i diff = _mm512_sub_epi64(a, b);
+        unsigned g = _mm512_cmplt_epu64_mask(a, b);
+        unsigned p = _mm512_cmpeq_epu64_mask(diff, zero);
+        unsigned m = ((g << 1) | borrow) + p;
+        borrow = m >> 8;
+        _mm512_storeu_si512(out + i, _mm512_mask_add_epi64(diff, static_cast<__mmask8>(m ^ p), diff, ones));
+    }
+    return sub_tail(out + i, x + i, y + i, n - i, borrow);
+}
+
+
+/**
+ * @brief BMI2/ADX row kernel out += x * y over n limbs, two limbs per iteration
+ * @param out Accumulator limbs (must not overlap x)
+ * @param x Multiplicand limbs
+ * @param n Number of limbs
+ * @param y Single limb multiplier
+ * @returns Carry limb out of the top of out
+ */
+__attribute__((target("bmi2,adx")))
+inline LimbSimd::limb_t LimbSimd::addmul_1_adx(limb_t *out, const limb_t *x, size_t n, limb_t y) {
+    limb_t carry = 0;
+    if (n & 1) {
+        unsigned __int128 prod = static_cast<unsigned __int128>(x[0]) * y + out[0];
+        out[0] = static_cast<limb_t>(prod);
+        carry = static_cast<limb_t>(prod >> 64);
+        x++;
+        out++;
+    }
+    size_t pairs = n / 2;
+    if (pairs == 0) {
+        return carry;
+    }
+    limb_t lo, hi, lo2, hi2, zero = 0;
+    __asm__ volatile(
+        "xor %k[lo], %k[lo]\n\t"            // clears CF and OF
+        "1:\n\t"
+        "mulx (%[x]), %[lo], %[hi]\n\t"
+        "mulx 8(%[x]), %[lo2], %[hi2]\n\t"
+        "adox %[carry], %[lo]\n\t"
+        "adcx (%[out]), %[lo]\n\t"
+        "mov %[lo], (%[out])\n\t"
+        "adox %[hi], %[lo2]\n\t"
+        "adcx 8(%[out]), %[lo2]\n\t"
+        "mov %[lo2], 8(%[out])\n\t"
+        "mov %[hi2], %[carry]\n\t"
+        "lea 16(%[x]), %[x]\n\t"           // lea and jrcxz leave the flags alone
+        "lea 16(%[out]), %[out]\n\t"
+        "lea -1(%[pairs]), %[pairs]\n\t"
+        "jrcxz 2f\n\t"
+        "jmp 1b\n\t"
+        "2:\n\t"
+        "adox %[zero], %[carry]\n\t"
+        "adcx %[zero], %[carry]\n\t"
+        : [carry] "+&r"(carry), [lo] "=&r"(lo), [hi] "=&r"(hi), [lo2] "=&r"(lo2), [hi2] "=&r"(hi2),
+          [x] "+&r"(x), [out] "+&r"(out), [pairs] "+c"(pairs)
+        : "d"(y), [zero] "r"(zero)
+        : "cc", "memory");
+    return carry;
+}
+
+
+/**
+ * @brief BMI2/ADX row kernel out -= x * y over n limbs, two limbs per iteration; out - t is computed as out + ~t + 1
+ * so the borrows also run on the carry flag (adcx)
+ * @param out Accumulator limbs (must not overlap x)
+ * @param x Multiplicand limbs
+ * @param n Number of limbs
+ * @param y Single limb multiplier
+ * @returns Borrow limb to subtract from the limb above out
+ */
+__attribute__((target("bmi2,adx")))
+inline LimbSimd::limb_t LimbSimd::submul_1_adx(limb_t *out, const limb_t *x, size_t n, limb_t y) {
+    limb_t carry = 0;
+    if (n & 1) {
+        unsigned __int128 prod = static_cast<unsigned __int128>(x[0]) * y;
+        limb_t low = static_cast<limb_t>(prod);
+        carry = static_cast<limb_t>(prod >> 64) + (out[0] < low);
+        out[0] -= low;
+        x++;
+        out++;
+    }
+    size_t pairs = n / 2;
+    if (pairs == 0) {
+        return carry;
+    }
+    limb_t lo, hi, lo2, hi2, zero = 0;
+    __asm__ volatile(
+        "xor %k[lo], %k[lo]\n\t"            // clears CF and OF
+        "stc\n\t"                           // CF set: no borrow
+        "1:\n\t"
+        "mulx (%[x]), %[lo], %[hi]\n\t"
+        "mulx 8(%[x]), %[lo2], %[hi2]\n\t"
+        "adox %[carry], %[lo]\n\t"
+        "not %[lo]\n\t"
+        "adcx (%[out]), %[lo]\n\t"
+        "mov %[lo], (%[out])\n\t"
+        "adox %[hi], %[lo2]\n\t"
+        "not %[lo2]\n\t"
+        "adcx 8(%[out]), %[lo2]\n\t"
+        "mov %[lo2], 8(%[out])\n\t"
+        "mov %[hi2], %[carry]\n\t"
+        "lea 16(%[x]), %[x]\n\t"
+        "lea 16(%[out]), %[out]\n\t"
+        "lea -1(%[pairs]), %[pairs]\n\t"
+        "jrcxz 2f\n\t"
+        "jmp 1b\n\t"
+        "2:\n\t"
+        "adox %[zero], %[carry]\n\t"
+        "cmc\n\t"                           // CF now set on a final borrow
+        "adcx %[zero], %[carry]\n\t"
+        : [carry] "+&r"(carry), [lo] "=&r"(lo), [hi] "=&r"(hi), [lo2] "=&r"(lo2), [hi2] "=&r"(hi2),
+          [x] "+&r"(x), [out] "+&r"(out), [pairs] "+c"(pairs)
+        : "d"(y), [zero] "r"(zero)
+        : "cc", "memory");
+    return carry;
+}
+#endif
+
+#endif
@@ -0,0 +1,270 @@
+#ifndef LIMB_VECTOR_H
+#define LIMB_VECTOR_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <iterator>
+#include <algorithm>
+#include <initializer_list>
+#include <memory_resource>
+
+#include "memory_scope.h"
+
+
+/**
+ * @brief Contiguous limb container with small-buffer optimization used as UBigInt storage.
+ * Keeps up to inline_capacity limbs inside the object itself and only spills to heap storage past that,
+ * so values up to 256 bits never allocate. Heap storage comes from a std::pmr::memory_resource (MemoryScope::current() unless given).
+ * Offers the subset of the std::vector interface UBigInt relies on.
+ */
+class LimbVector {
+public:
+    using value_type = std::uint64_t;
+    using size_type = size_t;
+    using iterator = value_type*;
+    using const_iterator = const value_type*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    static constexpr size_t inline_capacity = 4;
+
+    LimbVector() noexcept : data_{inline_} {}
+    explicit LimbVector(std::pmr::memory_resource *resource) noexcept : data_{inline_}, resource_{resource} {}
+    inline LimbVector(std::initializer_list<value_type> init);
+    inline LimbVector(const LimbVector &rhs);
+    inline LimbVector(LimbVector &&rhs) noexcept;
+    inline LimbVector& operator=(const LimbVector &rhs);
+    inline LimbVector& operator=(LimbVector &&rhs);
+    ~LimbVector() {release();}
+
+    std::pmr::memory_resource* get_resource() const {return resource_;}
+    size_t size() const {return size_;}
+    size_t capacity() const {return capacity_;}
+    bool empty() const {return size_ == 0;}
+    value_type* data() {return data_;}
+    const value_type* data() const {return data_;}
+    iterator begin() {return data_;}
+    iterator end() {return data_ + size_;}
+    const_iterator begin() const {return data_;}
+    const_iterator end() const {return data_ + size_;}
+    reverse_iterator rbegin() {return reverse_iterator(end());}
+    reverse_iterator rend() {return reverse_iterator(begin());}
+    const_reverse_iterator rbegin() const {return const_reverse_iterator(end());}
+    const_reverse_iterator rend() const {return const_reverse_iterator(begin());}
+    value_type& operator[](size_t i) {return data_[i];}
+    const value_type& operator[](size_t i) const {return data_[i];}
+    value_type& back() {return data_[size_ - 1];}
+    const value_type& back() const {return data_[size_ - 1];}
+
+    inline void reserve(size_t n);
+    inline void resize(size_t n, value_type value=0);
+    inline void assign(size_t n, value_type value);
+    template <typename Iter>
+    inline void assign(Iter first, Iter last);
+    inline void push_back(value_type value);
+    void pop_back() {size_--;}
+    void clear() {size_ = 0;}
+    inline iterator insert(const_iterator pos, size_t n, value_type value);
+    inline friend bool operator==(const LimbVector &lhs, const LimbVector &rhs);
+    inline friend bool operator!=(const LimbVector &lhs, const LimbVector &rhs);
+
+private:
+    value_type *data_;
+    size_t size_ = 0;
+    size_t capacity_ = inline_capacity;
+    std::pmr::memory_resource *resource_ = MemoryScope::current();
+    value_type inline_[inline_capacity];
+    bool is_inline() const {return data_ == inline_;}
+    inline void release();
+};
+
+
+/**
+ * @brief LimbVector initializer list ctor
+ * @param init limbs to copy (least significant first)
+ */
+inline LimbVector::LimbVector(std::initializer_list<value_type> init) : data_{inline_} {
+    assign(init.begin(), init.end());
+}
+
+
+/**
+ * @brief LimbVector copy ctor; copies into inline storage when the limbs fit, else allocates from MemoryScope::current()
+ * @param rhs LimbVector to copy
+ */
+inline LimbVector::LimbVector(const LimbVector &rhs) : data_{inline_} {
+    assign(rhs.begin(), rhs.end());
+}
+
+
+/**
+ * @brief LimbVector move ctor; steals heap storage along with its memory resource, copies inline storage
+ * @param rhs LimbVector to move from (left empty)
+ */
+inline LimbVector::LimbVector(LimbVector &&rhs) noexcept : data_{inline_}, resource_{rhs.resource_} {
+    *this = std::move(rhs);
+}
+
+
+/**
+ * @brief LimbVector copy assignment; reuses existing capacity
+ * @param rhs LimbVector to copy
+ * @returns Reference to modified instance
+ */
+inline LimbVector& LimbVector::operator=(const LimbVector &rhs) {
+    if (this != &rhs) {
+        assign(rhs.begin(), rhs.end());
+    }
+    return *this;
+}
+
+
+/**
+ * @brief LimbVector move assignment; steals heap storage when both use the same memory resource, otherwise copies into this resource
+ * @param rhs LimbVector to move from (left empty)
+ * @returns Reference to modified instance
+ */
+inline LimbVector& LimbVector::operator=(LimbVector &&rhs) {
+    if (this == &rhs) {
+        return *this;
+    }
+    if (rhs.is_inline() || !resource_->is_equal(*rhs.resource_)) {
+        assign(rhs.begin(), rhs.end());
+    }
+    else {
+        release();
+        data_ = rhs.data_;
+        size_ = rhs.size_;
+        capacity_ = rhs.capacity_;
+        rhs.data_ = rhs.inline_;
+        rhs.capacity_ = inline_capacity;
+    }
+    rhs.size_ = 0;
+    return *this;
+}
+
+
+/**
+ * @brief Frees heap storage (if any) and returns to empty inline storage
+ */
+inline void LimbVector::release() {
+    if (!is_inline()) {
+        resource_->deallocate(data_, capacity_ * sizeof(value_type), alignof(value_type));
+        data_ = inline_;
+        capacity_ = inline_capacity;
+    }
+    size_ = 0;
+}
+
+
+/**
+ * @brief Grows capacity to at least n limbs (at least doubling), spilling to the heap when past inline capacity
+ * @param n Requested capacity
+ */
+inline void LimbVector::reserve(size_t n) {
+    if (n <= capacity_) {
+        return;
+    }
+    size_t new_capacity = std::max(n, capacity_ * 2);
+    auto new_data = static_cast<value_type*>(resource_->allocate(new_capacity * sizeof(value_type), alignof(value_type)));
+    std::copy(begin(), end(), new_data);
+    size_t old_size = size_;
+    release();
+    data_ = new_data;
+    size_ = old_size;
+    capacity_ = new_capacity;
+}
+
+
+/**
+ * @brief Resizes to n limbs, filling new limbs with value
+ * @param n New size
+ * @param value Fill value of new limbs (Default=0)
+ */
+inline void LimbVector::resize(size_t n, value_type value) {
+    reserve(n);
+    if (n > size_) {
+        std::fill(data_ + size_, data_ + n, value);
+    }
+    size_ = n;
+}
+
+
+/**
+ * @brief Replaces contents with n copies of value
+ * @param n New size
+ * @param value Fill value
+ */
+inline void LimbVector::assign(size_t n, value_type value) {
+    size_ = 0;
+    resize(n, value);
+}
+
+
+/**
+ * @brief Replaces contents with a copy of the range [first, last)
+ * @param first beginning iterator of range to copy
+ * @param last end iterator of range to copy
+ */
+template <typename Iter>
+inline void LimbVector::assign(Iter first, Iter last) {
+    size_t n = std::distance(first, last);
+    size_ = 0;
+    reserve(n);
+    std::copy(first, last, data_);
+    size_ = n;
+}
+
+
+/**
+ * @brief Appends a limb at the most significant end
+ * @param value Limb to append
+ */
+inline void LimbVector::push_back(value_type value) {
+    if (size_ == capacity_) {
+        reserve(size_ + 1);
+    }
+    data_[size_++] = value;
+}
+
+
+/**
+ * @brief Inserts n copies of value before pos
+ * @param pos Position to insert before
+ * @param n Number of limbs to insert
+ * @param value Value of inserted limbs
+ * @returns Iterator to first inserted limb
+ */
+inline LimbVector::iterator LimbVector::insert(const_iterator pos, size_t n, value_type value) {
+    size_t offset = pos - data_;
+    reserve(size_ + n);
+    std::copy_backward(data_ + offset, data_ + size_, data_ + size_ + n);
+    std::fill(data_ + offset, data_ + offset + n, value);
+    size_ += n;
+    return data_ + offset;
+}
+
+
+/**
+ * @brief Overloaded LimbVector equal to comparison operator
+ * @param lhs LimbVector reference lhs of comparison
+ * @param rhs LimbVector reference rhs of comparison
+ * @returns True if both hold the same limbs
+ */
+inline bool operator==(const LimbVector &lhs, const LimbVector &rhs) {
+    return lhs.size_ == rhs.size_ && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+
+/**
+ * @brief Overloaded LimbVector not-equal to comparison operator
+ * @param lhs LimbVector reference lhs of comparison
+ * @param rhs LimbVector reference rhs of comparison
+ * @returns True if comparison operator == returns false
+ */
+inline bool operator!=(const LimbVector &lhs, const LimbVector &rhs) {
+    return !(lhs == rhs);
+}
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef MEMORY_SCOPE_H
+#define MEMORY_SCOPE_H
+
+#include <memory_resource>
+
+
+/**
+ * @brief Bump/arena allocator for UBigInt/BigInt storage; allocation is a pointer bump and memory is only reclaimed on release() or destruction
+ */
+using MemoryArena = std::pmr::monotonic_buffer_resource;
+
+
+/**
+ * @brief RAII guard selecting the memory resource used by every UBigInt/BigInt constructed on this thread while the guard is alive.
+ * Guards nest; the previous resource is restored on destruction. Values constructed inside the scope must not outlive the resource.
+ */
+class MemoryScope {
+public:
+    explicit MemoryScope(std::pmr::memory_resource *resource) : previous{current_} {current_ = resource;}
+    MemoryScope(const MemoryScope &rhs) = delete;
+    MemoryScope& operator=(const MemoryScope &rhs) = delete;
+    ~MemoryScope() {current_ = previous;}
+    inline static std::pmr::memory_resource* current();
+    inline static std::pmr::memory_resource* scratch();
+
+private:
+    std::pmr::memory_resource *previous;
+    static inline thread_local std::pmr::memory_resource *current_ = nullptr;
+};
+
+
+/**
+ * @brief Resource newly constructed values allocate from on this thread
+ * @returns Innermost scoped resource, or std::pmr::get_default_resource() outside of any MemoryScope
+ */
+inline std::pmr::memory_resource* MemoryScope::current() {
+    return current_ ? current_ : std::pmr::get_default_resource();
+}
+
+
+/**
+ * @brief Resource recursive algorithms use for their temporaries.
+ * Inside a MemoryScope this is the scoped resource; otherwise a per-thread size-class pool that never contends with other threads.
+ * @returns Scratch memory resource for the calling thread
+ */
+inline std::pmr::memory_resource* MemoryScope::scratch() {
+    if (current_) {
+        return current_;
+    }
+    static thread_local std::pmr::unsynchronized_pool_resource pool;
+    return &pool;
+}
+
+#endif
@@ -0,0 +1,278 @@
+#ifndef NTT_H
+#define NTT_H
+
+#include <cstdint>
+#include <vector>
+#include <memory_resource>
+#include <algorithm>
+#include <stdexcept>
+
+#include "memory_scope.h"
+#include "thread_pool.h"
+
+
+/**
+ * @brief Exact multi-prime number-theoretic-transform (NTT) multiplication of limb arrays.
+ * Whole 64-bit limbs are convolved modulo three ~62-bit NTT primes and every coefficient is recombined by CRT (Garner),
+ * which is exact (no floating point) for operands up to 2^55 limbs. Modular products use Montgomery reduction.
+ */
+class Ntt {
+public:
+    using limb_t = std::uint64_t;
+    using dlimb_t = unsigned __int128;
+    inline static void multiply(const limb_t *lhs, size_t lhs_size, const limb_t *rhs, size_t rhs_size, limb_t *out);
+
+private:
+    /**
+     * @brief NTT prime p = c*2^k+1 with primitive root g and its Montgomery (R = 2^64) constants
+     */
+    struct Prime {
+        limb_t p;
+        limb_t g;
+        limb_t neg_inv;
+        limb_t r2;
+        inline explicit Prime(limb_t p, limb_t g);
+        limb_t add(limb_t a, limb_t b) const {a += b; return a >= p ? a - p : a;}
+        limb_t sub(limb_t a, limb_t b) const {return a >= b ? a - b : a + p - b;}
+        inline limb_t mont_mul(limb_t a, limb_t b) const;
+        limb_t to_mont(limb_t a) const {return mont_mul(a, r2);}
+        inline limb_t pow(limb_t base, limb_t exp) const;
+    };
+    using scratch_vector = std::pmr::vector<limb_t>;
+    static constexpr int max_log_size = 55;
+    inline static const Prime& prime(int i);
+    inline static void forward(scratch_vector &a, const Prime &pr, const scratch_vector &roots);
+    inline static void inverse(scratch_vector &a, const Prime &pr, const scratch_vector &roots);
+    inline static void root_table(scratch_vector &roots, const Prime &pr, size_t n, bool invert);
+    inline static void convolve(const limb_t *lhs, size_t lhs_size, const limb_t *rhs, size_t rhs_size, size_t n, const Prime &pr, scratch_vector &result);
+};
+
+
+/**
+ * @brief Prime ctor; derives -p^-1 mod 2^64 and R^2 mod p
+ * @param p NTT prime below 2^62
+ * @param g Primitive root modulo p
+ */
+inline Ntt::Prime::Prime(limb_t p, limb_t g) : p{p}, g{g} {
+    limb_t inv = p;
+    for (int i = 0; i < 6; i++) {
+        inv *= 2 - p * inv;
+    }
+    neg_inv = 0 - inv;
+    dlimb_t r = (static_cast<dlimb_t>(1) << 64) % p;
+    r2 = static_cast<limb_t>(r * r % p);
+}
+
+
+/**
+ * @brief Montgomery product
+ * @param a Factor below p
+ * @param b Factor below p
+ * @returns a*b*2^-64 mod p
+ */
+inline Ntt::limb_t Ntt::Prime::mont_mul(limb_t a, limb_t b) const {
+    dlimb_t t = static_cast<dlimb_t>(a) * b;
+    limb_t m = static_cast<limb_t>(t) * neg_inv;
+    limb_t u = static_cast<limb_t>((t + static_cast<dlimb_t>(m) * p) >> 64);
+    return u >= p ? u - p : u;
+}
+
+
+/**
+ * @brief Modular exponentiation in Montgomery form
+ * @param base Base in Montgomery form
+ * @param exp Exponent
+ * @returns base^exp in Montgomery form
+ */
+inline Ntt::limb_t Ntt::Prime::pow(limb_t base, limb_t exp) const {
+    limb_t result = to_mont(1);
+    while (exp) {
+        if (exp & 1) {
+            result = mont_mul(result, base);
+        }
+        base = mont_mul(base, base);
+        exp >>= 1;
+    }
+    return result;
+}
+
+
+/**
+ * @brief The three NTT primes (29*2^57+1, 27*2^56+1, 69*2^55+1); product exceeds 2^184
+ * @param i Prime index (0..2)
+ * @returns Reference to prime constants
+ */
+inline const Ntt::Prime& Ntt::prime(int i) {
+    static const Prime primes[3] = {Prime{4179340454199820289ull, 3},
+                                    Prime{1945555039024054273ull, 5},
+                                    Prime{2485986994308513793ull, 5}};
+    return primes[i];
+}
+
+
+/**
+ * @brief Builds twiddle factors for all stages; roots[h + j] = w_(2h)^j (Montgomery form) for h = 1, 2, 4, ..., n/2
+ * @param roots Output table of size n
+ * @param pr Prime to build roots for
+ * @param n Transform length (power of two)
+ * @param invert Build inverse roots
+ */
+inline void Ntt::root_table(scratch_vector &roots, const Prime &pr, size_t n, bool invert) {
+    roots.assign(n, 0);
+    for (size_t h = 1; h < n; h *= 2) {
+        limb_t w = pr.pow(pr.to_mont(pr.g), (pr.p - 1) / (2 * h));
+        if (invert) {
+            w = pr.pow(w, pr.p - 2);
+        }
+        limb_t cur = pr.to_mont(1);
+        for (size_t j = 0; j < h; j++) {
+            roots[h + j] = cur;
+            cur = pr.mont_mul(cur, w);
+        }
+    }
+}
+
+
+/**
+ * @brief In-place decimation-in-frequency transform; natural order in, bit-reversed order out
+ * @param a Coefficients reduced mod p
+ * @param pr Prime of the transform
+ * @param roots Forward root table
+ */
+inline void Ntt::forward(scratch_vector &a, const Prime &pr, const scratch_vector &roots) {
+    size_t n = a.size();
+    for (size_t h = n / 2; h >= 1; h /= 2) {
+        for (size_t i = 0; i < n; i += 2 * h) {
+            for (size_t j = 0; j < h; j++) {
+                limb_t u = a[i + j];
+                limb_t v = a[i + j + h];
+                a[i + j] = pr.add(u, v);
+                a[i + j + h] = pr.mont_mul(pr.sub(u, v), roots[h + j]);
+            }
+        }
+    }
+}
+
+
+/**
+ * @brief In-place decimation-in-time inverse transform (unscaled); bit-reversed order in, natural order out
+ * @param a Transformed coefficients
+ * @param pr Prime of the transform
+ * @param roots Inverse root table
+ */
+inline void Ntt::inverse(scratch_vector &a, const Prime &pr, const scratch_vector &roots) {
+    size_t n = a.size();
+    for (size_t h = 1; h < n; h *= 2) {
+        for (size_t i = 0; i < n; i += 2 * h) {
+            for (size_t j = 0; j < h; j++) {
+                limb_t u = a[i + j];
+                limb_t v = pr.mont_mul(a[i + j + h], roots[h + j]);
+                a[i + j] = pr.add(u, v);
+                a[i + j + h] = pr.sub(u, v);
+            }
+        }
+    }
+}
+
+
+/**
+ * @brief Cyclic convolution of two limb arrays modulo one prime
+ * @param lhs Left hand limbs
+ * @param lhs_size Number of lhs limbs
+ * @param rhs Right hand limbs
+ * @param rhs_size Number of rhs limbs
+ * @param n Transform length (power of two >= lhs_size + rhs_size - 1)
+ * @param pr Prime of the transform
+ * @param result Output coefficients mod p (size n)
+ */
+inline void Ntt::convolve(const limb_t *lhs, size_t lhs_size, const limb_t *rhs, size_t rhs_size, size_t n, const Prime &pr, scratch_vector &result) {
+    // a square (lhs aliases rhs) needs only one forward transform
+    bool squaring = lhs == rhs && lhs_size == rhs_size;
+    scratch_vector roots{MemoryScope::scratch()};
+    scratch_vector other{MemoryScope::scratch()};
+    result.assign(n, 0);
+    for (size_t i = 0; i < lhs_size; i++) {
+        result[i] = lhs[i] % pr.p;
+    }
+    root_table(roots, pr, n, false);
+    forward(result, pr, roots);
+    if (!squaring) {
+        other.assign(n, 0);
+        for (size_t i = 0; i < rhs_size; i++) {
+            other[i] = rhs[i] % pr.p;
+        }
+        forward(other, pr, roots);
+    }
+    const scratch_vector &factor = squaring ? result : other;
+    // pointwise product leaves a factor 2^-64 which the final scale by n^-1 * 2^128 cancels
+    limb_t scale = pr.pow(pr.to_mont(n), pr.p - 2);
+    scale = pr.mont_mul(scale, pr.r2);
+    for (size_t i = 0; i < n; i++) {
+        result[i] = pr.mont_mul(result[i], factor[i]);
+    }
+    root_table(roots, pr, n, true);
+    inverse(result, pr, roots);
+    for (size_t i = 0; i < n; i++) {
+        result[i] = pr.mont_mul(result[i], scale);
+    }
+}
+
+
+/**
+ * @brief Multiplies two limb arrays; out must hold lhs_size + rhs_size limbs and not alias the inputs
+ * @param lhs Left hand limbs (least significant first)
+ * @param lhs_size Number of lhs limbs (> 0)
+ * @param rhs Right hand limbs (least significant first)
+ * @param rhs_size Number of rhs limbs (> 0)
+ * @param out Product limbs
+ */
+inline void Ntt::multiply(const limb_t *lhs, size_t lhs_size, const limb_t *rhs, size_t rhs_size, limb_t *out) {
+    size_t coefficients = lhs_size + rhs_size - 1;
+    size_t n = 1;
+    while (n < coefficients) {
+        n *= 2;
+    }
+    if (n > (size_t{1} << max_log_size)) {
+        throw std::length_error("Operands too large for NTT multiplication.");
+    }
+    const Prime &p0 = prime(0), &p1 = prime(1), &p2 = prime(2);
+    // the three convolutions are independent; in parallel each runs on its own thread's scratch and only the results,
+    // which the calling thread frees, come from the synchronized heap
+    std::pmr::memory_resource *results = ParallelScope::pool() ? std::pmr::new_delete_resource() : MemoryScope::scratch();
+    scratch_vector r[3] = {scratch_vector{results}, scratch_vector{results}, scratch_vector{results}};
+    parallel_for(3, [&](size_t i) {
+        MemoryScope scratch{MemoryScope::scratch()};
+        convolve(lhs, lhs_size, rhs, rhs_size, n, prime(static_cast<int>(i)), r[i]);
+    });
+    const scratch_vector &r0 = r[0], &r1 = r[1], &r2 = r[2];
+
+    // Garner: x = r0 + p0*k1 + p0*p1*k2 with k1 < p1, k2 < p2
+    const limb_t inv_p0_mod_p1 = p1.pow(p1.to_mont(p0.p % p1.p), p1.p - 2);
+    const dlimb_t p0p1 = static_cast<dlimb_t>(p0.p) * p1.p;
+    const limb_t inv_p0p1_mod_p2 = p2.pow(p2.to_mont(static_cast<limb_t>(p0p1 % p2.p)), p2.p - 2);
+    const limb_t p0p1_lo = static_cast<limb_t>(p0p1);
+    const limb_t p0p1_hi = static_cast<limb_t>(p0p1 >> 64);
+
+    limb_t carry0 = 0, carry1 = 0, carry2 = 0;
+    for (size_t i = 0; i < lhs_size + rhs_size; i++) {
+        if (i < coefficients) {
+            limb_t k1 = p1.mont_mul(p1.sub(r1[i], r0[i] % p1.p), inv_p0_mod_p1);
+            dlimb_t x01 = static_cast<dlimb_t>(p0.p) * k1 + r0[i];
+            limb_t k2 = p2.mont_mul(p2.sub(r2[i], static_cast<limb_t>(x01 % p2.p)), inv_p0p1_mod_p2);
+            dlimb_t lo = static_cast<dlimb_t>(p0p1_lo) * k2;
+            dlimb_t hi = static_cast<dlimb_t>(p0p1_hi) * k2 + static_cast<limb_t>(lo >> 64);
+            // add x = x01 + (hi:lo64) into the running 192-bit carry
+            dlimb_t sum = static_cast<dlimb_t>(carry0) + static_cast<limb_t>(lo) + static_cast<limb_t>(x01);
+            carry0 = static_cast<limb_t>(sum);
+            sum = (sum >> 64) + carry1 + static_cast<limb_t>(hi) + static_cast<limb_t>(x01 >> 64);
+            carry1 = static_cast<limb_t>(sum);
+            carry2 += static_cast<limb_t>(sum >> 64) + static_cast<limb_t>(hi >> 64);
+        }
+        out[i] = carry0;
+        carry0 = carry1;
+        carry1 = carry2;
+        carry2 = 0;
+    }
+}
+
+#endif
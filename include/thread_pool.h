@@ -0,0 +1,297 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <exception>
+#include <algorithm>
+
+
+/**
+ * @brief Set of tasks submitted to a ThreadPool that is waited on as a whole; keeps the first exception a task threw
+ */
+class TaskGroup {
+public:
+    TaskGroup() = default;
+    TaskGroup(const TaskGroup &rhs) = delete;
+    TaskGroup& operator=(const TaskGroup &rhs) = delete;
+
+private:
+    std::atomic<size_t> remaining{0};
+    std::mutex mutex;
+    std::exception_ptr error;
+    inline void fail(std::exception_ptr e);
+
+    friend class ThreadPool;
+};
+
+
+/**
+ * @brief Work-stealing thread pool.
+ * Every worker owns a task deque: it pushes and pops its own tasks at the back (depth first) and, when that runs dry, steals
+ * the oldest task from the front of another deque. Threads outside the pool submit into an extra shared deque.
+ * A thread waiting on a TaskGroup executes pending tasks until the group finishes, so tasks may spawn and wait on nested groups.
+ */
+class ThreadPool {
+public:
+    inline explicit ThreadPool(size_t threads=default_threads());
+    ThreadPool(const ThreadPool &rhs) = delete;
+    ThreadPool& operator=(const ThreadPool &rhs) = delete;
+    inline ~ThreadPool();
+    size_t size() const {return workers.size();}
+    template <typename F>
+    inline void run(TaskGroup &group, F task);
+    inline void wait(TaskGroup &group);
+    inline static size_t default_threads();
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::mutex sleep_mutex;
+    std::condition_variable wake;
+    std::atomic<size_t> pending{0};
+    bool stop = false;
+    static inline thread_local ThreadPool *worker_pool = nullptr;
+    static inline thread_local size_t worker_index = 0;
+    inline size_t own_queue() const;
+    inline bool take(std::function<void()> &task);
+    inline void work(size_t index);
+};
+
+
+/**
+ * @brief RAII guard enabling parallel multiplication for every UBigInt/BigInt product computed on this thread while the guard is alive.
+ * The top depth levels of the multiplication recursion run their independent sub-products as tasks on pool; deeper levels run serially.
+ * Results are identical to the serial algorithms. Guards nest; the previous setting is restored on destruction.
+ */
+class ParallelScope {
+public:
+    ParallelScope(ThreadPool *pool, size_t depth=3) : previous_pool{pool_}, previous_depth{depth_} {pool_ = pool; depth_ = depth;}
+    ParallelScope(const ParallelScope &rhs) = delete;
+    ParallelScope& operator=(const ParallelScope &rhs) = delete;
+    ~ParallelScope() {pool_ = previous_pool; depth_ = previous_depth;}
+    static ThreadPool* pool() {return depth_ ? pool_ : nullptr;}
+    static size_t depth() {return pool_ ? depth_ : 0;}
+
+private:
+    ThreadPool *previous_pool;
+    size_t previous_depth;
+    static inline thread_local ThreadPool *pool_ = nullptr;
+    static inline thread_local size_t depth_ = 0;
+};
+
+
+/**
+ * @brief Records the first exception thrown by a task of the group
+ * @param e Exception to record
+ */
+inline void TaskGroup::fail(std::exception_ptr e) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!error) {
+        error = e;
+    }
+}
+
+
+/**
+ * @brief Default worker count; one less than the hardware threads since the waiting thread helps execute tasks
+ * @returns Number of worker threads
+ */
+inline size_t ThreadPool::default_threads() {
+    return std::max(1u, std::thread::hardware_concurrency()) - 1;
+}
+
+
+/**
+ * @brief ThreadPool ctor; starts the workers
+ * @param threads Number of worker threads (0 runs every task on the waiting thread)
+ */
+inline ThreadPool::ThreadPool(size_t threads) {
+    for (size_t i = 0; i <= threads; i++) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    for (size_t i = 0; i < threads; i++) {
+        workers.emplace_back([this, i] {work(i);});
+    }
+}
+
+
+/**
+ * @brief ThreadPool dtor; stops and joins the workers (all task groups must have been waited on)
+ */
+inline ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        stop = true;
+    }
+    wake.notify_all();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+
+
+/**
+ * @brief Submits a task to the group; it runs on a worker or on a thread waiting in wait()
+ * @param group TaskGroup the task belongs to
+ * @param task Callable without arguments
+ */
+template <typename F>
+inline void ThreadPool::run(TaskGroup &group, F task) {
+    group.remaining.fetch_add(1, std::memory_order_relaxed);
+    // Counted before the push so a concurrent take() can never decrement pending below zero
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    Queue &queue = *queues[own_queue()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.emplace_back([&group, task = std::move(task)]() mutable {
+            try {
+                task();
+            }
+            catch (...) {
+                group.fail(std::current_exception());
+            }
+            group.remaining.fetch_sub(1, std::memory_order_release);
+        });
+    }
+    wake.notify_one();
+}
+
+
+/**
+ * @brief Executes pending tasks until every task of the group has finished
+ * @param group TaskGroup to wait on
+ * @throws The first exception thrown by a task of the group
+ */
+inline void ThreadPool::wait(TaskGroup &group) {
+    while (group.remaining.load(std::memory_order_acquire) != 0) {
+        std::function<void()> task;
+        if (take(task)) {
+            task();
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+    if (group.error) {
+        std::rethrow_exception(group.error);
+    }
+}
+
+
+/**
+ * @brief Index of the calling thread's deque (the shared deque for threads outside the pool)
+ * @returns Queue index
+ */
+inline size_t ThreadPool::own_queue() const {
+    return worker_pool == this ? worker_index : queues.size() - 1;
+}
+
+
+/**
+ * @brief Pops the newest task of the calling thread's deque, else steals the oldest task of another deque
+ * @param task Receives the task
+ * @returns True if a task was taken
+ */
+inline bool ThreadPool::take(std::function<void()> &task) {
+    size_t own = own_queue();
+    for (size_t i = 0; i < queues.size(); i++) {
+        Queue &queue = *queues[(own + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) {
+            continue;
+        }
+        if (i == 0) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+        else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        pending.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+
+/**
+ * @brief Worker loop; runs tasks while there are any and sleeps otherwise
+ * @param index Worker (and deque) index
+ */
+inline void ThreadPool::work(size_t index) {
+    worker_pool = this;
+    worker_index = index;
+    while (true) {
+        std::function<void()> task;
+        if (take(task)) {
+            task();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        wake.wait(lock, [this] {return stop || pending.load(std::memory_order_relaxed) > 0;});
+        if (stop) {
+            return;
+        }
+    }
+}
+
+
+/**
+ * @brief Runs f(0), ..., f(count - 1) as tasks on the ParallelScope pool, one parallel level deeper, with the calling thread
+ * running f(0) itself and helping until all have finished. Runs them in order on the calling thread without an active ParallelScope
+ * @param count Number of calls
+ * @param f Callable taking the call index
+ */
+template <typename F>
+inline void parallel_for(size_t count, F f) {
+    ThreadPool *pool = ParallelScope::pool();
+    if (!pool || count < 2) {
+        for (size_t i = 0; i < count; i++) {
+            f(i);
+        }
+        return;
+    }
+    size_t depth = ParallelScope::depth() - 1;
+    TaskGroup group;
+    for (size_t i = 1; i < count; i++) {
+        pool->run(group, [&f, i, pool, depth] {
+            ParallelScope scope{pool, depth};
+            f(i);
+        });
+    }
+    std::exception_ptr error;
+    try {
+        ParallelScope scope{pool, depth};
+        f(0);
+    }
+    catch (...) {
+        error = std::current_exception();
+    }
+    if (error) {
+        try {
+            pool->wait(group);
+        }
+        catch (...) {
+        }
+        std::rethrow_exception(error);
+    }
+    pool->wait(group);
+}
+
+#endif
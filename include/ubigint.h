@@ -1,29 +1,113 @@
 #ifndef UBIGINT_H
 #define UBIGINT_H
 
+#include <cstdint>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
 #include <deque>
 #include <string>
-#include <stack>
+#include <string_view>
+#include <charconv>
+#include <cstring>
+#include <ostream>
+#include <istream>
+#include <stdexcept>
 #include <type_traits>
-#include <unordered_map>
 #include <numeric>
 #include <algorithm>
+#include <utility>
+#include <functional>
+
+#include "limb_vector.h"
+#include "ntt.h"
+#include "cpu_dispatch.h"
+#include "thread_pool.h"
+
+
+/**
+ * @brief Minimum operand sizes (in limbs, smaller operand) at which multiplication switches algorithm
+ */
+struct MulThresholds {
+    size_t karatsuba = 32;
+    size_t toom3 = 250;
+    size_t toom4 = 1000;
+    size_t ntt = 5000;
+    size_t parallel = 128;  ///< Run sub-products as parallel tasks from this size on when a ParallelScope is active
+};
+
+
+/**
+ * @brief Non-owning, read-only view of a run of limbs (least significant limb first), e.g. one half of a UBigInt.
+ * Slicing is O(1) and never copies; the viewed limbs must outlive the view
+ */
+class UBigIntView {
+public:
+    using limb_t = std::uint64_t;
+
+    UBigIntView() = default;
+    UBigIntView(const limb_t *data, size_t size) : data_{data}, size_{size} {}
+    const limb_t* data() const {return data_;}
+    size_t size() const {return size_;}
+    bool empty() const {return size_ == 0;}
+    limb_t operator[](size_t i) const {return data_[i];}
+    inline UBigIntView trimmed() const;
+    inline UBigIntView slice(size_t start_index, size_t end_index) const;
+
+private:
+    const limb_t *data_ = nullptr;
+    size_t size_ = 0;
+};
+
+
+/**
+ * @brief View without most significant zero limbs
+ * @returns Trimmed view over the same limbs
+ */
+inline UBigIntView UBigIntView::trimmed() const {
+    size_t n = size_;
+    while (n > 0 && data_[n - 1] == 0) {
+        n--;
+    }
+    return UBigIntView(data_, n);
+}
+
+
+/**
+ * @brief O(1) limb slice [start_index, end_index) clamped to the view, without most significant zero limbs
+ * @param start_index Index of first limb in slice
+ * @param end_index Index one past the last limb in slice
+ * @returns Trimmed view over the sliced limbs
+ */
+inline UBigIntView UBigIntView::slice(size_t start_index, size_t end_index) const {
+    end_index = std::min(end_index, size_);
+    start_index = std::min(start_index, end_index);
+    return UBigIntView(data_ + start_index, end_index - start_index).trimmed();
+}
 
 
 /**
  * @brief Signed arbitrarily "big" precision unsigned integer class; Handles magnitude manipulation for BigInt class as a member by composition; Can be used stand-alone
- * Uses std::deque<int> for dynamic storage
+ * Uses a small-buffer LimbVector of 64-bit binary limbs (least significant limb first) for storage; values up to 256 bits never touch the heap.
+ * Larger values allocate from a std::pmr::memory_resource (see MemoryScope); multiplication and division temporaries use MemoryScope::scratch()
  */
 class UBigInt {
 public:
+    using limb_t = std::uint64_t;
+    using dlimb_t = unsigned __int128;
+    static constexpr int limb_bits = 64;
+
     UBigInt() = default;
+    explicit UBigInt(std::pmr::memory_resource *resource) : num{resource} {}
     inline UBigInt(char rhs);
-    inline UBigInt(std::string s);
+    inline UBigInt(std::string_view s);
     template <class T,
               typename std::enable_if<std::is_integral<T>::value, int>::type* = nullptr>
     inline UBigInt(T rhs);
     template <typename Iter>
     inline UBigInt(Iter begin, Iter end);
+    inline explicit UBigInt(UBigIntView view);
     UBigInt(const UBigInt &rhs) = default;
     UBigInt(UBigInt &&rhs) = default;
     UBigInt& operator=(const UBigInt &rhs) = default;
@@ -33,15 +117,59 @@ public:
     inline UBigInt& operator-=(const UBigInt &rhs);
     inline UBigInt& operator*=(const UBigInt &rhs);
     inline UBigInt& operator/=(const UBigInt &rhs);
+    inline UBigInt& operator%=(const UBigInt &rhs);
+    inline UBigInt& operator&=(const UBigInt &rhs);
+    inline UBigInt& operator|=(const UBigInt &rhs);
+    inline UBigInt& operator^=(const UBigInt &rhs);
+    inline UBigInt& operator<<=(size_t m);
+    inline UBigInt& operator>>=(size_t m);
     inline UBigInt& operator++();
     inline UBigInt& operator--();
     inline UBigInt operator++(int);
     inline UBigInt operator--(int);
-    inline friend std::ostream& operator<<(std::ostream &out, const UBigInt rhs);
+    inline friend std::ostream& operator<<(std::ostream &out, const UBigInt &rhs);
+    inline friend std::istream& operator>>(std::istream &in, UBigInt &rhs);
+    inline friend std::to_chars_result to_chars(char *first, char *last, const UBigInt &value);
+    inline friend std::from_chars_result from_chars(const char *first, const char *last, UBigInt &value);
     inline friend UBigInt operator+(const UBigInt &lhs, const UBigInt &rhs);
     inline friend UBigInt operator-(const UBigInt &lhs, const UBigInt &rhs);
     inline friend UBigInt operator*(const UBigInt &lhs, const UBigInt &rhs);
     inline friend UBigInt operator/(const UBigInt &lhs, const UBigInt &rhs);
+    inline friend UBigInt operator%(const UBigInt &lhs, const UBigInt &rhs);
+    inline friend UBigInt operator+(UBigInt &&lhs, const UBigInt &rhs);
+    inline friend UBigInt operator+(const UBigInt &lhs, UBigInt &&rhs);
+    inline friend UBigInt operator+(UBigInt &&lhs, UBigInt &&rhs);
+    inline friend UBigInt operator-(UBigInt &&lhs, const UBigInt &rhs);
+    inline friend UBigInt operator-(const UBigInt &lhs, UBigInt &&rhs);
+    inline friend UBigInt operator-(UBigInt &&lhs, UBigInt &&rhs);
+    inline friend UBigInt operator*(UBigInt &&lhs, const UBigInt &rhs);
+    inline friend UBigInt operator*(const UBigInt &lhs, UBigInt &&rhs);
+    inline friend UBigInt operator*(UBigInt &&lhs, UBigInt &&rhs);
+    inline friend UBigInt operator/(UBigInt &&lhs, const UBigInt &rhs);
+    inline friend UBigInt operator/(const UBigInt &lhs, UBigInt &&rhs);
+    inline friend UBigInt operator/(UBigInt &&lhs, UBigInt &&rhs);
+    inline friend UBigInt operator%(UBigInt &&lhs, const UBigInt &rhs);
+    inline friend UBigInt operator%(const UBigInt &lhs, UBigInt &&rhs);
+    inline friend UBigInt operator%(UBigInt &&lhs, UBigInt &&rhs);
+    inline friend UBigInt operator&(const UBigInt &lhs, const UBigInt &rhs);
+    inline friend UBigInt operator|(const UBigInt &lhs, const UBigInt &rhs);
+    inline friend UBigInt operator^(const UBigInt &lhs, const UBigInt &rhs);
+    inline friend UBigInt operator&(UBigInt &&lhs, const UBigInt &rhs);
+    inline friend UBigInt operator|(UBigInt &&lhs, const UBigInt &rhs);
+    inline friend UBigInt operator^(UBigInt &&lhs, const UBigInt &rhs);
+    inline friend UBigInt operator<<(const UBigInt &lhs, size_t m);
+    inline friend UBigInt operator>>(const UBigInt &lhs, size_t m);
+    inline friend UBigInt operator<<(UBigInt &&lhs, size_t m);
+    inline friend UBigInt operator>>(UBigInt &&lhs, size_t m);
+    inline friend std::pair<UBigInt, UBigInt> divmod(const UBigInt &lhs, const UBigInt &rhs);
+    inline friend UBigInt& addmul(UBigInt &acc, const UBigInt &lhs, const UBigInt &rhs);
+    inline friend UBigInt& submul(UBigInt &acc, const UBigInt &lhs, const UBigInt &rhs);
+    inline friend UBigInt& addmul_ui(UBigInt &acc, const UBigInt &lhs, std::uint64_t rhs);
+    inline friend UBigInt& submul_ui(UBigInt &acc, const UBigInt &lhs, std::uint64_t rhs);
+    inline friend UBigInt pow(const UBigInt &base, const UBigInt &exp);
+    inline friend UBigInt pow(const UBigInt &base, std::uint64_t exp);
+    inline friend UBigInt powmod(const UBigInt &base, const UBigInt &exp, const UBigInt &mod);
+    inline friend int compare(const UBigInt &lhs, const UBigInt &rhs);
     inline friend bool operator<(const UBigInt &lhs, const UBigInt &rhs);
     inline friend bool operator>(const UBigInt &lhs, const UBigInt &rhs);
     inline friend bool operator==(const UBigInt &lhs, const UBigInt &rhs);
@@ -49,86 +177,148 @@ public:
     inline friend bool operator>=(const UBigInt &lhs, const UBigInt &rhs);
     inline friend bool operator!=(const UBigInt &lhs, const UBigInt &rhs);
     inline UBigInt& power(const UBigInt &rhs);
+    inline UBigInt& power(std::uint64_t rhs);
+    inline UBigInt& square();
     inline UBigInt& randomize(const size_t &length);
     inline UBigInt& shift10(int m=1);
-    inline UBigInt get_slice(size_t start_index, size_t end_index);
-    size_t get_length() {return num.size();}
+    inline UBigInt get_slice(size_t start_index, size_t end_index) const;
+    inline std::string to_string() const;
+    inline size_t get_length() const;
+    size_t get_limb_count() const {return num.size();}
+    inline size_t get_bit_length() const;
+    inline size_t hash() const;
+    inline bool test_bit(size_t i) const;
+    inline UBigInt& set_bit(size_t i, bool value=true);
+    UBigIntView view() const {return UBigIntView(num.data(), num.size());}
+    std::pmr::memory_resource* get_resource() const {return num.get_resource();}
 
 private:
-    std::deque<int> num;
-    inline UBigInt long_multiplication(const UBigInt &lhs, const UBigInt &rhs);
-    inline UBigInt divide_primative(const UBigInt &rhs);
-    inline UBigInt long_division(const UBigInt &rhs);
+    LimbVector num;
+    static constexpr limb_t decimal_chunk = 10000000000000000000ull;
+    static constexpr int decimal_chunk_digits = 19;
+    static constexpr size_t decimal_conversion_thres = 20;
+    static constexpr size_t decimal_buffer_size = decimal_conversion_thres * 20;
+    static constexpr size_t burnikel_ziegler_thres = 40;
+    static constexpr size_t burnikel_ziegler_offset = 40;
+    static constexpr size_t newton_division_thres = 16000;
+    static constexpr size_t newton_reciprocal_base = 200;
+    inline void trim();
+    inline UBigInt& subtract(const UBigInt &rhs);
+    inline UBigInt& subtract_from(const UBigInt &lhs);
+    inline void mul_add_limb(limb_t m, limb_t a);
+    inline limb_t div_limb(limb_t d);
+    template <typename Iter, typename F>
+    inline void read_digits(Iter begin, Iter end, F chunk_of);
+    template <typename Iter, typename F>
+    inline static UBigInt read_decimal(Iter begin, size_t length, F chunk_of);
+    inline static limb_t read_chars(const char *p, size_t n);
+    inline static const UBigInt& decimal_power(size_t level);
+    inline static void write_decimal(const UBigInt &x, size_t level, bool pad, std::string &out);
+    inline static size_t write_decimal_chunks(const UBigInt &x, char *out, size_t size);
+    inline UBigInt get_limb_slice(size_t start_index, size_t end_index) const;
+    inline UBigInt& shift_limbs(size_t m);
+    inline UBigInt& shift_bits(long m);
+    inline bool any_bit_below(size_t m) const;
+    inline static limb_t add_n(limb_t *out, const limb_t *x, const limb_t *y, size_t n);
+    inline static limb_t sub_n(limb_t *out, const limb_t *x, const limb_t *y, size_t n);
+    inline static limb_t add_1(limb_t *out, const limb_t *x, size_t n, limb_t y);
+    inline static limb_t sub_1(limb_t *out, const limb_t *x, size_t n, limb_t y);
+    inline static limb_t addmul_1(limb_t *out, const limb_t *x, size_t n, limb_t y);
+    inline static limb_t submul_1(limb_t *out, const limb_t *x, size_t n, limb_t y);
+    inline static void mul_basecase(limb_t *out, const limb_t *x, size_t xn, const limb_t *y, size_t yn);
+    inline static void sqr_basecase(limb_t *out, const limb_t *x, size_t n);
+    inline static UBigInt long_multiplication(const UBigInt &lhs, const UBigInt &rhs);
+    inline static UBigInt long_square(const UBigInt &x);
+    inline static UBigInt multiply(const UBigInt &lhs, const UBigInt &rhs, const MulThresholds &thres);
+    inline static UBigInt karatsuba(const UBigInt &lhs, const UBigInt &rhs, const MulThresholds &thres);
+    inline static size_t karatsuba_scratch_size(size_t n, const MulThresholds &thres, size_t depth);
+    inline static void karatsuba_kernel(limb_t *out, UBigIntView lhs, UBigIntView rhs, limb_t *scratch, const MulThresholds &thres);
+    inline static void multiply_parts(const UBigInt *const *lhs, const UBigInt *const *rhs, UBigInt *out, size_t count, const MulThresholds &thres);
+    inline static bool subtract_abs(limb_t *out, UBigIntView x, UBigIntView y, size_t n);
+    inline static UBigInt toom3(const UBigInt &lhs, const UBigInt &rhs, const MulThresholds &thres);
+    inline static UBigInt toom4(const UBigInt &lhs, const UBigInt &rhs, const MulThresholds &thres);
+    inline static void toom4_evaluate(const UBigInt &x, size_t k, UBigInt (&v)[7], bool (&neg)[7]);
+    inline static void signed_add(UBigInt &a, bool &a_neg, const UBigInt &b, bool b_neg);
+    inline static void signed_add_product(UBigInt &a, bool &a_neg, const UBigInt &lhs, const UBigInt &rhs, bool product_neg, const MulThresholds &thres);
+    inline static UBigInt ntt_multiplication(const UBigInt &lhs, const UBigInt &rhs);
+    inline static void divide(const UBigInt &lhs, const UBigInt &rhs, UBigInt &quo, UBigInt &rem);
+    inline static void long_division(const UBigInt &lhs, const UBigInt &rhs, UBigInt &quo, UBigInt &rem);
+    inline static void burnikel_ziegler(const UBigInt &lhs, const UBigInt &rhs, UBigInt &quo, UBigInt &rem);
+    inline static void divide_2n1n(const UBigInt &a, const UBigInt &b, size_t n, UBigInt &quo, UBigInt &rem);
+    inline static void divide_3n2n(const UBigInt &a, const UBigInt &b, size_t h, UBigInt &quo, UBigInt &rem);
+    inline static void newton_division(const UBigInt &lhs, const UBigInt &rhs, UBigInt &quo, UBigInt &rem);
+    inline static UBigInt reciprocal(const UBigInt &v);
+    template <typename Mul>
+    inline static UBigInt window_power(const UBigInt &base, const UBigInt &exp, Mul mul);
+    inline static limb_t montgomery_inverse(limb_t m0);
+    inline static UBigInt montgomery_multiply(const UBigInt &a, const UBigInt &b, const UBigInt &m, limb_t m_inv);
+    inline static UBigInt montgomery_reduce(UBigInt t, const UBigInt &m, limb_t m_inv);
+
+    friend class BigInt;
+    friend struct LazyAccumulator;
 };
 
 
 /**
  * @brief UBigInt single char ctor
  * @param rhs character to place into magnitude
- * @param negative negative sign (Default=0)
  */
-inline UBigInt::UBigInt(char rhs): num{rhs-'0'} {}
+inline UBigInt::UBigInt(char rhs) {
+    if (rhs < '0' || rhs > '9') {
+        throw std::runtime_error("Invalid character in char");
+    }
+    if (rhs != '0') {
+        num = {static_cast<limb_t>(rhs - '0')};
+    }
+}
 
 
 /**
- * @brief UBigInt std::string ctor
- * @param s std::string to parse into num
+ * @brief UBigInt string ctor; skips leading spaces, signs and zeros, the rest must be decimal digits
+ * @param s String to parse into num
  */
-inline UBigInt::UBigInt(std::string s) {
-    std::unordered_map<char,int> s2num{{'0',0}, {'1',1}, {'2',2},
-                                       {'3',3}, {'4',4}, {'5',5},
-                                       {'6',6}, {'7',7}, {'8',8},{'9',9}};
-    int i = 0;
-    while (s[i] == ' ') {
-        i++;
-    }
-    while (s[i] == '0' || s[i] == '+' || s[i] == '-') {
+inline UBigInt::UBigInt(std::string_view s) {
+    size_t i = 0;
+    while (i < s.size() && s[i] == ' ') {
         i++;
     }
-    while (i < s.size()) {
-        if (s2num.find(s[i]) == s2num.end()) {
-            throw std::runtime_error("Invalid character in string");
-        }
-        num.push_back(s2num[s[i]]);
+    while (i < s.size() && (s[i] == '0' || s[i] == '+' || s[i] == '-')) {
         i++;
     }
-    if (num.empty()) {
-        num = {0};
+    if (i < s.size() && from_chars(s.data() + i, s.data() + s.size(), *this).ptr != s.data() + s.size()) {
+        throw std::runtime_error("Invalid character in string");
     }
-};
+}
 
 
 /**
  * @brief UBigInt generic integral ctor
- * @param rhs integral value to place in num
+ * @param rhs integral value to place in num (sign is discarded)
  */
 template <class T,
             typename std::enable_if<std::is_integral<T>::value, int>::type*>
 inline UBigInt::UBigInt(T rhs) {
-    std::stack<int> st;
-    if (rhs == 0) {
-        num = {0};
-    }
+    using U = typename std::conditional<std::is_same<T, bool>::value, unsigned, typename std::make_unsigned<T>::type>::type;
+    U mag = static_cast<U>(rhs);
     if (rhs < 0) {
-        rhs = -1 * rhs;
+        mag = U(0) - mag;
     }
-    while (rhs > 0) {
-        int pop = rhs % 10;
-        st.push(pop);
-        rhs = rhs/10;
-    }
-    while (!st.empty()) {
-        num.push_back(st.top());
-        st.pop();
+    while (mag > 0) {
+        num.push_back(static_cast<limb_t>(mag));
+        if constexpr (sizeof(U) > sizeof(limb_t)) {
+            mag >>= limb_bits;
+        }
+        else {
+            mag = 0;
+        }
     }
 }
 
 
 /**
  * @brief UBigInt generic iterator ctor
- * @param begin beginning iterator of range to copy
+ * @param begin beginning iterator of range of decimal digits (most significant first) to copy
  * @param end end iterator of range to copy
- * @param negative negative sign (Default=0)
  */
 template <typename Iter>
 inline UBigInt::UBigInt(Iter begin, Iter end) {
@@ -137,30 +327,126 @@ inline UBigInt::UBigInt(Iter begin, Iter end) {
             throw std::runtime_error("BigIntCpp cannot construct iterator elements outside of range(0,9)");
         }
     }
-    num = std::deque<int>{begin, end};
+    read_digits(begin, end, [](Iter it, size_t n) {
+        limb_t chunk = 0;
+        for (size_t i = 0; i < n; i++, it++) {
+            chunk = chunk * 10 + static_cast<limb_t>(*it);
+        }
+        return chunk;
+    });
 }
 
 
+/**
+ * @brief UBigInt ctor copying the limbs of a view
+ * @param view Limbs to copy (least significant first)
+ */
+inline UBigInt::UBigInt(UBigIntView view) {
+    num.assign(view.data(), view.data() + view.size());
+    trim();
+}
+
 
 /**
- * @brief Overloaded UBigInt insertion operator prints sign and value of UBigInt
+ * @brief Overloaded UBigInt insertion operator prints value of UBigInt in decimal
  * @param out Output stream reference
  * @param rhs Subject UBigInt refence to stream
  * @returns Reference to output stream
  */
-inline std::ostream& operator<<(std::ostream& out, const UBigInt rhs) {
-    for (const auto it : rhs.num) {
-        std::cout << it;
+inline std::ostream& operator<<(std::ostream &out, const UBigInt &rhs) {
+    if (rhs.num.size() < UBigInt::decimal_conversion_thres) {
+        char buffer[UBigInt::decimal_buffer_size];
+        auto result = to_chars(buffer, buffer + sizeof(buffer), rhs);
+        out.write(buffer, result.ptr - buffer);
+    }
+    else {
+        out << rhs.to_string();
     }
     return out;
 }
 
 
 /**
- * @brief Overloaded UBigInt equal to comparison operator 
+ * @brief Overloaded UBigInt extraction operator reads a run of decimal digits after leading whitespace; sets failbit if there is none
+ * @param in Input stream reference
+ * @param rhs UBigInt reference read into
+ * @returns Reference to input stream
+ */
+inline std::istream& operator>>(std::istream &in, UBigInt &rhs) {
+    std::istream::sentry sentry{in};
+    if (!sentry) {
+        return in;
+    }
+    std::string digits;
+    for (auto c = in.peek(); c >= '0' && c <= '9'; c = in.peek()) {
+        digits.push_back(static_cast<char>(in.get()));
+    }
+    if (from_chars(digits.data(), digits.data() + digits.size(), rhs).ec != std::errc{}) {
+        in.setstate(std::ios_base::failbit);
+    }
+    return in;
+}
+
+
+/**
+ * @brief Writes the decimal representation into [first, last) without allocating (for values below decimal_conversion_thres limbs)
+ * @param first Beginning of the output buffer
+ * @param last End of the output buffer
+ * @param value UBigInt reference to print
+ * @returns {end of written digits, std::errc{}}, or {last, std::errc::value_too_large} if the buffer is too small
+ */
+inline std::to_chars_result to_chars(char *first, char *last, const UBigInt &value) {
+    size_t size = last - first;
+    size_t length;
+    if (value.num.size() < UBigInt::decimal_conversion_thres) {
+        length = UBigInt::write_decimal_chunks(value, first, size);
+    }
+    else {
+        std::string s = value.to_string();
+        length = s.size() <= size ? s.size() : 0;
+        std::memcpy(first, s.data(), length);
+    }
+    if (length == 0) {
+        return {last, std::errc::value_too_large};
+    }
+    return {first + length, std::errc{}};
+}
+
+
+/**
+ * @brief Parses the longest run of decimal digits at the start of [first, last); digits are validated and converted eight at a time
+ * @param first Beginning of the input
+ * @param last End of the input
+ * @param value UBigInt reference parsed into (unchanged on error)
+ * @returns {end of parsed digits, std::errc{}}, or {first, std::errc::invalid_argument} if the input does not start with a digit
+ */
+inline std::from_chars_result from_chars(const char *first, const char *last, UBigInt &value) {
+    const char *p = first;
+    while (last - p >= 8) {
+        std::uint64_t eight;
+        std::memcpy(&eight, p, 8);
+        // every byte in '0'..'9': high nibble 3 before and after adding 6
+        if (((eight & 0xF0F0F0F0F0F0F0F0) | (((eight + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) != 0x3333333333333333) {
+            break;
+        }
+        p += 8;
+    }
+    while (p != last && *p >= '0' && *p <= '9') {
+        p++;
+    }
+    if (p == first) {
+        return {first, std::errc::invalid_argument};
+    }
+    value.read_digits(first, p, UBigInt::read_chars);
+    return {p, std::errc{}};
+}
+
+
+/**
+ * @brief Overloaded UBigInt equal to comparison operator
  * @param lhs UBigInt reference lhs of comparison
  * @param rhs UBigInt reference rhs of comparison
- * @returns True if lhs number is equal to rhs number 
+ * @returns True if lhs number is equal to rhs number
  */
 inline bool operator==(const UBigInt &lhs, const UBigInt &rhs) {
     return lhs.num == rhs.num;
@@ -168,69 +454,73 @@ inline bool operator==(const UBigInt &lhs, const UBigInt &rhs) {
 
 
 /**
- * @brief Overloaded UBigInt less than comparison operator. Compares number of digits then if number(digits) equal, compares the content of digits.
+ * @brief Three-way comparison in a single pass; compares limb counts, then limbs from the most significant until the first difference
  * @param lhs UBigInt reference lhs of comparison
  * @param rhs UBigInt reference rhs of comparison
- * @returns True if lhs number magnitude is less than rhs number
+ * @returns Negative if lhs < rhs, zero if lhs == rhs, positive if lhs > rhs
  */
-inline bool operator<(const UBigInt &lhs, const UBigInt &rhs) {
-    if (lhs.num.size() < rhs.num.size()) {
-        return true;
+inline int compare(const UBigInt &lhs, const UBigInt &rhs) {
+    size_t n = lhs.num.size();
+    if (n != rhs.num.size()) {
+        return n < rhs.num.size() ? -1 : 1;
     }
-    else if (lhs.num.size() > rhs.num.size() || lhs == rhs) {
-        return false;
-    }
-    else {
-        auto mispair = std::mismatch(lhs.num.begin(), lhs.num.end(), rhs.num.begin());
-        return *mispair.first < *mispair.second;
+    const UBigInt::limb_t *x = lhs.num.data();
+    const UBigInt::limb_t *y = rhs.num.data();
+    while (n--) {
+        if (x[n] != y[n]) {
+            return x[n] < y[n] ? -1 : 1;
+        }
     }
+    return 0;
+}
+
+
+/**
+ * @brief Overloaded UBigInt less than comparison operator
+ * @param lhs UBigInt reference lhs of comparison
+ * @param rhs UBigInt reference rhs of comparison
+ * @returns True if lhs number magnitude is less than rhs number
+ */
+inline bool operator<(const UBigInt &lhs, const UBigInt &rhs) {
+    return compare(lhs, rhs) < 0;
 }
 
 
 /**
- * @brief Overloaded UBigInt greater than comparison operator. Compares number of digits then if number(digits) equal, compares the content of digits.
+ * @brief Overloaded UBigInt greater than comparison operator
  * @param lhs UBigInt reference lhs of comparison
  * @param rhs UBigInt reference rhs of comparison
  * @returns True if lhs number magnitude is greater than rhs number
  */
 inline bool operator>(const UBigInt &lhs, const UBigInt &rhs) {
-    if (lhs.num.size() > rhs.num.size()) {
-        return true;
-    }
-    else if (lhs.num.size() < rhs.num.size() || lhs == rhs) {
-        return false;
-    }
-    else {
-        auto mispair = std::mismatch(lhs.num.begin(), lhs.num.end(), rhs.num.begin());
-        return *mispair.first > *mispair.second;
-    }
+    return compare(lhs, rhs) > 0;
 }
 
 
 /**
- * @brief Overloaded UBigInt less than or equal to operator.
+ * @brief Overloaded UBigInt less than or equal to operator
  * @param lhs UBigInt reference lhs of comparison
  * @param rhs UBigInt reference rhs of comparison
- * @returns True if comparison operator == returns true or operator < returns true
+ * @returns True if lhs number magnitude is less than or equal to rhs number
  */
 inline bool operator<=(const UBigInt &lhs, const UBigInt &rhs) {
-    return (lhs == rhs || lhs < rhs);
+    return compare(lhs, rhs) <= 0;
 }
 
 
 /**
- * @brief Overloaded UBigInt greater than or equal to operator.
+ * @brief Overloaded UBigInt greater than or equal to operator
  * @param lhs UBigInt reference lhs of comparison
  * @param rhs UBigInt reference rhs of comparison
- * @returns True if comparison operator == returns true or operator > returns true
+ * @returns True if lhs number magnitude is greater than or equal to rhs number
  */
-inline bool operator>=(const UBigInt &lhs, const UBigInt &rhs) { 
-    return (lhs == rhs || lhs > rhs);
+inline bool operator>=(const UBigInt &lhs, const UBigInt &rhs) {
+    return compare(lhs, rhs) >= 0;
 }
 
 
 /**
- * @brief Overloaded UBigInt not-equal to comparison operator 
+ * @brief Overloaded UBigInt not-equal to comparison operator
  * @param lhs BigInt reference lhs of comparison
  * @param rhs BigInt reference rhs of comparison
  * @returns True if comparison operator == returns false
@@ -243,26 +533,17 @@ inline bool operator!=(const UBigInt &lhs, const UBigInt &rhs) {
 /**
  * @brief Overloaded UBigInt addition assignment operator and core addition algorithm
  * @param rhs UBigInt reference added to *this
- * @returns Reference to modified instance 
+ * @returns Reference to modified instance
  */
 inline UBigInt& UBigInt::operator+=(const UBigInt &rhs) {
-    int carry = 0;
-    for (int i = 0; i < std::max(num.size(), rhs.num.size()); i++) {
-        int column_sum = carry;
-        if (i < rhs.num.size()) {
-            column_sum += rhs.num[rhs.num.size()-i-1];
-        }
-        if (i < num.size()) {
-            column_sum += num[num.size()-i-1];
-        }
-        else {
-            num.push_front(0);
-        }
-        num[num.size()-i-1] = column_sum > 9 ? (column_sum - 10) : column_sum;
-        carry = (column_sum > 9);
+    size_t n = rhs.num.size();
+    if (num.size() < n) {
+        num.resize(n, 0);
     }
+    limb_t carry = add_n(num.data(), num.data(), rhs.num.data(), n);
+    carry = add_1(num.data() + n, num.data() + n, num.size() - n, carry);
     if (carry) {
-        num.push_front(carry);
+        num.push_back(carry);
     }
     return *this;
 }
@@ -271,47 +552,24 @@ inline UBigInt& UBigInt::operator+=(const UBigInt &rhs) {
 /**
  * @brief Overloaded UBigInt subtraction assignment operator and core subtraction algorithm
  * @param rhs UBigInt reference *this is subtracted by
- * @returns Reference to modified instance 
+ * @returns Reference to modified instance
  */
 inline UBigInt& UBigInt::operator-=(const UBigInt &rhs) {
-    int borrow = 0;
-    if (rhs == *this) {
-        *this = 0;
-    }
-    else if (rhs > *this) {
+    if (compare(*this, rhs) < 0) {
         throw std::runtime_error("Negative value in UBigInt (unsigned) subtraction.");
     }
-    else {
-        for (int i = 0; i < num.size(); i++) {
-            int column_diff = -1 * borrow;
-            if (i < rhs.num.size()) {
-                column_diff -= rhs.num[rhs.num.size()-i-1];
-            }
-            column_diff += num[num.size()-i-1];
-            num[num.size()-i-1] = column_diff < 0 ? (column_diff+10) : column_diff;
-            borrow = (column_diff < 0);
-        }
-        /*
-            285119577441
-           -275452342542
-            ______________
-            009667234899 <-- can have multiple stray leading zeros in long subtraction
-        */
-        while (num.front() == 0) {
-            num.pop_front();
-        }
-    }
-    return *this;
+    return subtract(rhs);
 }
 
 
 /**
- * @brief Overloaded UBigInt multplication assignment operator
+ * @brief Overloaded UBigInt multplication assignment operator; a *= a is detected and squares
  * @param rhs UBigInt reference multplied by *this
- * @returns Reference to modified instance 
+ * @returns Reference to modified instance
  */
 inline UBigInt& UBigInt::operator*=(const UBigInt &rhs) {
-    *this = long_multiplication(*this, rhs);
+    MemoryScope scratch{MemoryScope::scratch()};
+    *this = multiply(*this, rhs, MulThresholds{});
     return *this;
 }
 
@@ -319,17 +577,34 @@ inline UBigInt& UBigInt::operator*=(const UBigInt &rhs) {
 /**
  * @brief Overloaded UBigInt division assignment operator
  * @param rhs UBigInt reference *this is divided by
- * @returns Reference to modified instance 
+ * @returns Reference to modified instance
  */
 inline UBigInt& UBigInt::operator/=(const UBigInt &rhs) {
-    *this = long_division(rhs);
+    MemoryScope scratch{MemoryScope::scratch()};
+    UBigInt quo, rem;
+    divide(*this, rhs, quo, rem);
+    *this = std::move(quo);
+    return *this;
+}
+
+
+/**
+ * @brief Overloaded UBigInt remainder assignment operator
+ * @param rhs UBigInt reference *this is divided by
+ * @returns Reference to modified instance holding the remainder
+ */
+inline UBigInt& UBigInt::operator%=(const UBigInt &rhs) {
+    MemoryScope scratch{MemoryScope::scratch()};
+    UBigInt quo, rem;
+    divide(*this, rhs, quo, rem);
+    *this = std::move(rem);
     return *this;
 }
 
 
 /**
- * @brief Overloaded BigInt postfix increment operator 
- * @returns Reference to modified instance 
+ * @brief Overloaded BigInt postfix increment operator
+ * @returns Reference to modified instance
  */
 inline UBigInt& UBigInt::operator++() {
     *this += 1;
@@ -338,8 +613,8 @@ inline UBigInt& UBigInt::operator++() {
 
 
 /**
- * @brief Overloaded BigInt postfix decrement operator 
- * @returns Reference to modified instance 
+ * @brief Overloaded BigInt postfix decrement operator
+ * @returns Reference to modified instance
  */
 inline UBigInt& UBigInt::operator--() {
     *this -= 1;
@@ -348,9 +623,9 @@ inline UBigInt& UBigInt::operator--() {
 
 
 /**
- * @brief Overloaded BigInt prefix increment operator 
+ * @brief Overloaded BigInt prefix increment operator
  * @param _ Placeholder integer argument
- * @returns Copy of new instance 
+ * @returns Copy of new instance
  */
 inline UBigInt UBigInt::operator++(int) {
     UBigInt pre(*this);
@@ -360,9 +635,9 @@ inline UBigInt UBigInt::operator++(int) {
 
 
 /**
- * @brief Overloaded BigInt prefix decrement operator 
+ * @brief Overloaded BigInt prefix decrement operator
  * @param _ Placeholder integer argument
- * @returns Copy of new instance 
+ * @returns Copy of new instance
  */
 inline UBigInt UBigInt::operator--(int) {
     UBigInt pre(*this);
@@ -372,209 +647,2260 @@ inline UBigInt UBigInt::operator--(int) {
 
 
 /**
- * @brief Overloaded UBigInt binary addition operator 
+ * @brief Overloaded UBigInt binary addition operator
  * @param lhs UBigInt reference lhs component of sum
  * @param rhs UBigInt reference rhs component of sum
- * @returns Copy of new instance 
+ * @returns Copy of new instance
  */
 inline UBigInt operator+(const UBigInt &lhs, const UBigInt &rhs) {
-    return UBigInt(lhs) += rhs;
+    return UBigInt(lhs) + rhs;
 }
 
 
 /**
- * @brief Overloaded UBigInt binary subtraction operator 
+ * @brief Overloaded UBigInt binary subtraction operator
  * @param lhs UBigInt reference lhs component of difference
  * @param rhs UBigInt reference rhs component of difference
- * @returns Copy of new instance 
+ * @returns Copy of new instance
  */
 inline UBigInt operator-(const UBigInt &lhs, const UBigInt &rhs) {
-    return UBigInt(lhs) -= rhs;
-} 
+    return UBigInt(lhs) - rhs;
+}
 
 
 /**
- * @brief Overloaded UBigInt binary multiplication operator 
+ * @brief Overloaded UBigInt binary multiplication operator; x * x squares
  * @param lhs UBigInt reference lhs component of product
  * @param rhs UBigInt reference rhs component of product
- * @returns Copy of new instance 
+ * @returns Copy of new instance
  */
 inline UBigInt operator*(const UBigInt &lhs, const UBigInt &rhs) {
-    return UBigInt(lhs) *= rhs;
+    if (&lhs == &rhs) {
+        return std::move(UBigInt(lhs).square());
+    }
+    return UBigInt(lhs) * rhs;
 }
 
 
 /**
- * @brief Overloaded UBigInt binary division operator 
+ * @brief Overloaded UBigInt binary division operator
  * @param lhs UBigInt reference lhs (numerator) component of product
  * @param rhs UBigInt reference rhs (denominator) component of product
- * @returns Copy of new instance 
+ * @returns Copy of new instance
  */
 inline UBigInt operator/(const UBigInt &lhs, const UBigInt &rhs) {
-    return UBigInt(lhs) /= rhs;
+    return UBigInt(lhs) / rhs;
 }
 
 
 /**
- * @brief Utility method which implements core long multiplication algorithm
- * @param lhs Left hand portion of multiplication algorithm
- * @param rhs Right hand portion of multiplication algorithm
- * @returns Copy of product instance
+ * @brief Overloaded UBigInt binary remainder operator
+ * @param lhs UBigInt reference lhs (numerator) of division
+ * @param rhs UBigInt reference rhs (denominator) of division
+ * @returns Copy of new instance holding lhs mod rhs
  */
-inline UBigInt UBigInt::long_multiplication(const UBigInt &lhs, const UBigInt &rhs) {
-    if (lhs == 0 || rhs == 0) {
-        return 0;
-    }
-    const std::deque<int> &top = num.size() >= rhs.num.size() ? num : rhs.num;
-    const std::deque<int> &bottom = num.size() < rhs.num.size() ? num : rhs.num;
-    std::deque<int> product;
-    int carry_mult;
-    int carry_add;
-    int offset;
-    for (int j = 0; j < bottom.size(); j++) {
-        carry_mult = 0;
-        carry_add = 0;
-        for(int i = 0; i < top.size(); i++) {
-            offset = i + j;
-            int prod = (top[top.size()-i-1] * bottom[bottom.size()-j-1]) + carry_mult;
-            int num_mult = prod % 10;
-            carry_mult = prod / 10;
-            if(product.size() < offset+1) {
-                product.push_front(0);
-            }
-            int sum = product[product.size()-offset-1] + num_mult + carry_add;
-            int num_add = (sum > 9) ? (sum - 10) : sum; 
-            carry_add = (sum > 9);
-            product[product.size()-offset-1]  = num_add;
-        }
-        if (carry_mult || carry_add) {
-            product.push_front(carry_mult + carry_add);
-        }
-    }
-    return UBigInt(product.begin(), product.end());
+inline UBigInt operator%(const UBigInt &lhs, const UBigInt &rhs) {
+    return UBigInt(lhs) % rhs;
+}
+
+
+/**
+ * @brief UBigInt binary addition operator reusing the storage of a temporary lhs
+ * @param lhs UBigInt rvalue lhs component of sum (result is built in its storage)
+ * @param rhs UBigInt reference rhs component of sum
+ * @returns lhs holding the sum
+ */
+inline UBigInt operator+(UBigInt &&lhs, const UBigInt &rhs) {
+    return std::move(lhs += rhs);
 }
 
 
 /**
- * @brief Utility primitive integer division algorithm which counts how many rhs in *this
- * @param rhs Divisor of division method
- * @returns Copy of quotient instance 
+ * @brief UBigInt binary addition operator reusing the storage of a temporary rhs
+ * @param lhs UBigInt reference lhs component of sum
+ * @param rhs UBigInt rvalue rhs component of sum (result is built in its storage)
+ * @returns rhs holding the sum
  */
-inline UBigInt UBigInt::divide_primative(const UBigInt &rhs) {
-    UBigInt count{0}; 
-    auto total = *this;
-    while (total >= rhs) {
-        total -= rhs;
-        count += UBigInt{1};
-    }
-    return count;
+inline UBigInt operator+(const UBigInt &lhs, UBigInt &&rhs) {
+    return std::move(rhs += lhs);
 }
 
 
 /**
- * @brief Utility method which implements core long division algorithm
- * @param rhs Divisor of division algo
- * @returns Copy of quotient instance
+ * @brief UBigInt binary addition operator for two temporaries; reuses the storage of lhs
+ * @param lhs UBigInt rvalue lhs component of sum
+ * @param rhs UBigInt rvalue rhs component of sum
+ * @returns lhs holding the sum
  */
-inline UBigInt UBigInt::long_division(const UBigInt &rhs) {
-    UBigInt temp{0};
-    UBigInt sol;
-    if (rhs > *this) {
-        return UBigInt{0};
-    }
-    else if (rhs == *this) {
-        return UBigInt{1};
-    }
-    else {
-        for (int i = 0; i < num.size();) {
-            temp = temp * 10 + num[i++];
-            UBigInt quo = temp.divide_primative(rhs);
-            for (const auto it : quo.num) {
-                if (!(sol.num.empty() && quo == 0)) {
-                    sol.num.push_back(it);
-                }
-            }
-            if (quo*rhs <= temp) {
-                temp = temp - (quo * rhs);
-            }
-        }
-        if (sol.num.empty()) {
-            return UBigInt{0};
-        }
-        else {
-            return sol;
-        }
-    }
+inline UBigInt operator+(UBigInt &&lhs, UBigInt &&rhs) {
+    return std::move(lhs += rhs);
 }
 
+
 /**
- * @brief  Randomizes UBigInt instance sign and magnitude to specified number of digits
- * @param length Specified number of digits
- * @returns Reference to modified UBigInt
+ * @brief UBigInt binary subtraction operator reusing the storage of a temporary lhs
+ * @param lhs UBigInt rvalue lhs component of difference (result is built in its storage)
+ * @param rhs UBigInt reference rhs component of difference
+ * @returns lhs holding the difference
  */
-inline UBigInt& UBigInt::randomize(const size_t &length) {
-    std::srand(std::time(nullptr));
-    std::vector<int> va(length);
-    std::generate(va.begin(), va.end(), [](){return std::rand() % 10;});
-    *this = UBigInt{va.begin(), va.end()};
-    return *this;
+inline UBigInt operator-(UBigInt &&lhs, const UBigInt &rhs) {
+    return std::move(lhs -= rhs);
 }
 
 
 /**
- * @brief  Utility method to extract slice of BigInt from a start to end index
- * @param  start_index Index of the beginning of the chunk to extract.
- * @param  end_index Index of the end of the chunk to extract.
- * @returns copy of extracted UBigInt
+ * @brief UBigInt binary subtraction operator reusing the storage of a temporary rhs
+ * @param lhs UBigInt reference lhs component of difference
+ * @param rhs UBigInt rvalue rhs component of difference (result is built in its storage)
+ * @returns rhs holding the difference
  */
-inline UBigInt UBigInt::get_slice(size_t start_index, size_t end_index) { 
-    while(num[start_index] == 0 && start_index < end_index) {
-        start_index++;
+inline UBigInt operator-(const UBigInt &lhs, UBigInt &&rhs) {
+    if (compare(lhs, rhs) < 0) {
+        throw std::runtime_error("Negative value in UBigInt (unsigned) subtraction.");
     }
-    return {num.begin()+start_index, num.begin()+end_index};
+    return std::move(rhs.subtract_from(lhs));
 }
 
 
 /**
- * @brief  UBigInt's primitive exponent utility method
- * @param rhs Exponent to raise base *this by
- * @returns Reference to modified UBigInt
+ * @brief UBigInt binary subtraction operator for two temporaries; reuses the storage of lhs
+ * @param lhs UBigInt rvalue lhs component of difference
+ * @param rhs UBigInt rvalue rhs component of difference
+ * @returns lhs holding the difference
  */
-inline UBigInt& UBigInt::power(const UBigInt &rhs) {
-    if (rhs == 0) {
-        *this = {1};
-    }
-    else {
-        const UBigInt base = *this;
-        UBigInt count {0};
-        while (count < rhs-1) {
-            *this *= base;
-            count++;
-        }
+inline UBigInt operator-(UBigInt &&lhs, UBigInt &&rhs) {
+    return std::move(lhs -= rhs);
+}
+
+
+/**
+ * @brief UBigInt binary multiplication operator reusing the storage of a temporary lhs for the product
+ * @param lhs UBigInt rvalue lhs component of product
+ * @param rhs UBigInt reference rhs component of product
+ * @returns lhs holding the product
+ */
+inline UBigInt operator*(UBigInt &&lhs, const UBigInt &rhs) {
+    return std::move(lhs *= rhs);
+}
+
+
+/**
+ * @brief UBigInt binary multiplication operator reusing the storage of a temporary rhs for the product
+ * @param lhs UBigInt reference lhs component of product
+ * @param rhs UBigInt rvalue rhs component of product
+ * @returns rhs holding the product
+ */
+inline UBigInt operator*(const UBigInt &lhs, UBigInt &&rhs) {
+    return std::move(rhs *= lhs);
+}
+
+
+/**
+ * @brief UBigInt binary multiplication operator for two temporaries; reuses the storage of lhs
+ * @param lhs UBigInt rvalue lhs component of product
+ * @param rhs UBigInt rvalue rhs component of product
+ * @returns lhs holding the product
+ */
+inline UBigInt operator*(UBigInt &&lhs, UBigInt &&rhs) {
+    return std::move(lhs *= rhs);
+}
+
+
+/**
+ * @brief UBigInt binary division operator reusing the storage of a temporary lhs for the quotient
+ * @param lhs UBigInt rvalue lhs (numerator) of division
+ * @param rhs UBigInt reference rhs (denominator) of division
+ * @returns lhs holding the quotient
+ */
+inline UBigInt operator/(UBigInt &&lhs, const UBigInt &rhs) {
+    return std::move(lhs /= rhs);
+}
+
+
+/**
+ * @brief UBigInt binary division operator reusing the storage of a temporary rhs for the quotient
+ * @param lhs UBigInt reference lhs (numerator) of division
+ * @param rhs UBigInt rvalue rhs (denominator) of division
+ * @returns rhs holding the quotient
+ */
+inline UBigInt operator/(const UBigInt &lhs, UBigInt &&rhs) {
+    MemoryScope scratch{MemoryScope::scratch()};
+    UBigInt quo, rem;
+    UBigInt::divide(lhs, rhs, quo, rem);
+    rhs = std::move(quo);
+    return std::move(rhs);
+}
+
+
+/**
+ * @brief UBigInt binary division operator for two temporaries; reuses the storage of lhs
+ * @param lhs UBigInt rvalue lhs (numerator) of division
+ * @param rhs UBigInt rvalue rhs (denominator) of division
+ * @returns lhs holding the quotient
+ */
+inline UBigInt operator/(UBigInt &&lhs, UBigInt &&rhs) {
+    return std::move(lhs /= rhs);
+}
+
+
+/**
+ * @brief UBigInt binary remainder operator reusing the storage of a temporary lhs for the remainder
+ * @param lhs UBigInt rvalue lhs (numerator) of division
+ * @param rhs UBigInt reference rhs (denominator) of division
+ * @returns lhs holding lhs mod rhs
+ */
+inline UBigInt operator%(UBigInt &&lhs, const UBigInt &rhs) {
+    return std::move(lhs %= rhs);
+}
+
+
+/**
+ * @brief UBigInt binary remainder operator reusing the storage of a temporary rhs for the remainder
+ * @param lhs UBigInt reference lhs (numerator) of division
+ * @param rhs UBigInt rvalue rhs (denominator) of division
+ * @returns rhs holding lhs mod rhs
+ */
+inline UBigInt operator%(const UBigInt &lhs, UBigInt &&rhs) {
+    MemoryScope scratch{MemoryScope::scratch()};
+    UBigInt quo, rem;
+    UBigInt::divide(lhs, rhs, quo, rem);
+    rhs = std::move(rem);
+    return std::move(rhs);
+}
+
+
+/**
+ * @brief UBigInt binary remainder operator for two temporaries; reuses the storage of lhs
+ * @param lhs UBigInt rvalue lhs (numerator) of division
+ * @param rhs UBigInt rvalue rhs (denominator) of division
+ * @returns lhs holding lhs mod rhs
+ */
+inline UBigInt operator%(UBigInt &&lhs, UBigInt &&rhs) {
+    return std::move(lhs %= rhs);
+}
+
+
+/**
+ * @brief Quotient and remainder from a single division pass
+ * @param lhs UBigInt reference lhs (numerator) of division
+ * @param rhs UBigInt reference rhs (denominator) of division
+ * @returns Pair of quotient and remainder
+ */
+inline std::pair<UBigInt, UBigInt> divmod(const UBigInt &lhs, const UBigInt &rhs) {
+    std::pair<UBigInt, UBigInt> result;
+    MemoryScope scratch{MemoryScope::scratch()};
+    UBigInt::divide(lhs, rhs, result.first, result.second);
+    return result;
+}
+
+
+/**
+ * @brief Fused multiply-add acc += lhs * rhs; small products are accumulated row by row into acc's storage without a temporary
+ * @param acc UBigInt reference accumulated into
+ * @param lhs Left hand factor
+ * @param rhs Right hand factor
+ * @returns Reference to acc
+ */
+inline UBigInt& addmul(UBigInt &acc, const UBigInt &lhs, const UBigInt &rhs) {
+    bool neg = false;
+    UBigInt::signed_add_product(acc, neg, lhs, rhs, false, MulThresholds{});
+    return acc;
+}
+
+
+/**
+ * @brief Fused multiply-subtract acc -= lhs * rhs; acc is left unchanged if the result would be negative
+ * @param acc UBigInt reference subtracted from
+ * @param lhs Left hand factor
+ * @param rhs Right hand factor
+ * @returns Reference to acc
+ */
+inline UBigInt& submul(UBigInt &acc, const UBigInt &lhs, const UBigInt &rhs) {
+    bool neg = false;
+    UBigInt::signed_add_product(acc, neg, lhs, rhs, true, MulThresholds{});
+    if (neg) {
+        UBigInt::signed_add_product(acc, neg, lhs, rhs, false, MulThresholds{});
+        throw std::runtime_error("Negative value in UBigInt (unsigned) subtraction.");
     }
-    return *this;
+    return acc;
 }
 
 
 /**
- * @brief  UBigInt's base-10 shift utility method; resizes if necessary
- * @param m Number of places to shift forward or back
- * @returns Reference to modified UBigInt
+ * @brief Fused multiply-add by a native scalar, acc += lhs * rhs
+ * @param acc UBigInt reference accumulated into
+ * @param lhs Left hand factor
+ * @param rhs Scalar factor
+ * @returns Reference to acc
  */
-inline UBigInt& UBigInt::shift10(int m) {
-    if(m > 0) {
-        num.resize(num.size() + m);
-    }
-    if(m < 0) {
-        for (int i = 0; i < std::abs(m); i++) {
-            if (num.empty()) {
-                num = {0};
-                return *this;
-            }
-            num.erase(num.end());
-        }
+inline UBigInt& addmul_ui(UBigInt &acc, const UBigInt &lhs, std::uint64_t rhs) {
+    return addmul(acc, lhs, UBigInt(rhs));
+}
+
+
+/**
+ * @brief Fused multiply-subtract by a native scalar, acc -= lhs * rhs; acc is left unchanged if the result would be negative
+ * @param acc UBigInt reference subtracted from
+ * @param lhs Left hand factor
+ * @param rhs Scalar factor
+ * @returns Reference to acc
+ */
+inline UBigInt& submul_ui(UBigInt &acc, const UBigInt &lhs, std::uint64_t rhs) {
+    return submul(acc, lhs, UBigInt(rhs));
+}
+
+
+/**
+ * @brief Utility method which drops most significant zero limbs so that zero is stored as an empty num
+ */
+inline void UBigInt::trim() {
+    while (!num.empty() && num.back() == 0) {
+        num.pop_back();
     }
+}
+
+
+/**
+ * @brief Utility method which computes *this -= rhs without comparing first (core of operator-=)
+ * @param rhs UBigInt reference subtrahend, must not exceed *this (may alias *this)
+ * @returns Reference to modified instance
+ */
+inline UBigInt& UBigInt::subtract(const UBigInt &rhs) {
+    size_t n = rhs.num.size();
+    limb_t borrow = sub_n(num.data(), num.data(), rhs.num.data(), n);
+    sub_1(num.data() + n, num.data() + n, num.size() - n, borrow);
+    trim();
     return *this;
 }
 
+
+/**
+ * @brief Utility method which computes *this = lhs - *this in place (reverse subtraction), reusing this storage, without comparing first
+ * @param lhs UBigInt reference minuend, must not be less than *this (may alias *this)
+ * @returns Reference to modified instance
+ */
+inline UBigInt& UBigInt::subtract_from(const UBigInt &lhs) {
+    size_t n = num.size();
+    num.resize(lhs.num.size(), 0);
+    limb_t borrow = sub_n(num.data(), lhs.num.data(), num.data(), n);
+    sub_1(num.data() + n, lhs.num.data() + n, num.size() - n, borrow);
+    trim();
+    return *this;
+}
+
+
+/**
+ * @brief Utility method which computes *this = *this * m + a in a single pass
+ * @param m Single limb multiplier
+ * @param a Single limb addend
+ */
+inline void UBigInt::mul_add_limb(limb_t m, limb_t a) {
+    limb_t carry = a;
+    for (auto &limb : num) {
+        dlimb_t prod = static_cast<dlimb_t>(limb) * m + carry;
+        limb = static_cast<limb_t>(prod);
+        carry = static_cast<limb_t>(prod >> limb_bits);
+    }
+    if (carry) {
+        num.push_back(carry);
+    }
+}
+
+
+/**
+ * @brief Utility method which divides *this in place by a single (non-zero) limb
+ * @param d Single limb divisor
+ * @returns Remainder of the division
+ */
+inline UBigInt::limb_t UBigInt::div_limb(limb_t d) {
+    limb_t rem = 0;
+    for (size_t i = num.size(); i-- > 0;) {
+        dlimb_t cur = (static_cast<dlimb_t>(rem) << limb_bits) | num[i];
+        num[i] = static_cast<limb_t>(cur / d);
+        rem = static_cast<limb_t>(cur % d);
+    }
+    trim();
+    return rem;
+}
+
+
+/**
+ * @brief Utility method which accumulates a range of decimal digits (most significant first) into num, 19 digits per limb operation.
+ * Long ranges are split recursively instead (see read_decimal)
+ * @param begin beginning iterator of digit range
+ * @param end end iterator of digit range
+ * @param chunk_of Callable (Iter it, size_t n) returning the value of the n <= 19 digits starting at it
+ */
+template <typename Iter, typename F>
+inline void UBigInt::read_digits(Iter begin, Iter end, F chunk_of) {
+    size_t length = std::distance(begin, end);
+    if (length >= decimal_conversion_thres * decimal_chunk_digits) {
+        MemoryScope scratch{MemoryScope::scratch()};
+        *this = read_decimal(begin, length, chunk_of);
+        return;
+    }
+    num.clear();
+    // leading partial chunk first so the remaining chunks are all full
+    size_t head = length % decimal_chunk_digits;
+    Iter it = begin;
+    if (head) {
+        mul_add_limb(decimal_chunk, chunk_of(it, head));
+        std::advance(it, head);
+    }
+    for (; it != end; std::advance(it, decimal_chunk_digits)) {
+        mul_add_limb(decimal_chunk, chunk_of(it, decimal_chunk_digits));
+    }
+}
+
+
+/**
+ * @brief Divide-and-conquer decimal parsing; splits off the low 19*2^k digits, converts both halves recursively and
+ * recombines them with one multiplication by the cached 10^(19*2^k), so parsing costs O(M(n) log n) instead of O(n^2)
+ * @param begin beginning iterator of digit range (most significant first)
+ * @param length Number of digits in the range
+ * @param chunk_of Callable (Iter it, size_t n) returning the value of the n <= 19 digits starting at it
+ * @returns Parsed value
+ */
+template <typename Iter, typename F>
+inline UBigInt UBigInt::read_decimal(Iter begin, size_t length, F chunk_of) {
+    UBigInt result;
+    if (length < decimal_conversion_thres * decimal_chunk_digits) {
+        result.read_digits(begin, std::next(begin, length), chunk_of);
+        return result;
+    }
+    size_t level = 0;
+    while ((size_t{decimal_chunk_digits} << (level + 1)) < length) {
+        level++;
+    }
+    size_t width = size_t{decimal_chunk_digits} << level;
+    result = multiply(read_decimal(begin, length - width, chunk_of), decimal_power(level), MulThresholds{});
+    result += read_decimal(std::next(begin, length - width), width, chunk_of);
+    return result;
+}
+
+
+/**
+ * @brief Utility method converting up to 19 validated ASCII digits; eight digits at a time are combined pairwise within one 64-bit word (SWAR)
+ * @param p First digit
+ * @param n Number of digits (at most 19)
+ * @returns Value of the digits
+ */
+inline UBigInt::limb_t UBigInt::read_chars(const char *p, size_t n) {
+    limb_t chunk = 0;
+    for (; n >= 8; n -= 8, p += 8) {
+        std::uint64_t eight;
+        std::memcpy(&eight, p, 8);
+        eight = (eight & 0x0F0F0F0F0F0F0F0F) * 2561 >> 8;
+        eight = (eight & 0x00FF00FF00FF00FF) * 6553601 >> 16;
+        eight = (eight & 0x0000FFFF0000FFFF) * 42949672960001 >> 32;
+        chunk = chunk * 100000000 + eight;
+    }
+    for (; n > 0; n--, p++) {
+        chunk = chunk * 10 + static_cast<limb_t>(*p - '0');
+    }
+    return chunk;
+}
+
+
+/**
+ * @brief Per-thread cache of the decimal conversion powers 10^(19*2^level), each the square of the previous one.
+ * Cached values live in std::pmr::new_delete_resource() so they never point into a scoped arena
+ * @param level Level of the power
+ * @returns Reference to 10^(19*2^level), valid for the lifetime of the thread
+ */
+inline const UBigInt& UBigInt::decimal_power(size_t level) {
+    static thread_local std::deque<UBigInt> powers;
+    while (powers.size() <= level) {
+        UBigInt next{std::pmr::new_delete_resource()};
+        if (powers.empty()) {
+            next = decimal_chunk;
+        }
+        else {
+            next = multiply(powers.back(), powers.back(), MulThresholds{});
+        }
+        powers.push_back(std::move(next));
+    }
+    return powers[level];
+}
+
+
+/**
+ * @brief Limb kernel out = x + y over n limbs; out may alias x or y. Runs the AVX-512/AVX2 or portable kernel selected by CpuDispatch
+ * @param out Sum limbs
+ * @param x Left hand limbs
+ * @param y Right hand limbs
+ * @param n Number of limbs
+ * @returns Carry out of the top limb (0 or 1)
+ */
+inline UBigInt::limb_t UBigInt::add_n(limb_t *out, const limb_t *x, const limb_t *y, size_t n) {
+    auto kernel = CpuDispatch::kernels().add_n;
+    if (kernel == CpuDispatch::add_n_generic) {
+        return CpuDispatch::add_n_generic(out, x, y, n);
+    }
+    return kernel(out, x, y, n);
+}
+
+
+/**
+ * @brief Limb kernel out = x - y over n limbs; out may alias x or y. Runs the AVX-512/AVX2 or portable kernel selected by CpuDispatch
+ * @param out Difference limbs
+ * @param x Left hand limbs
+ * @param y Right hand limbs
+ * @param n Number of limbs
+ * @returns Borrow out of the top limb (0 or 1)
+ */
+inline UBigInt::limb_t UBigInt::sub_n(limb_t *out, const limb_t *x, const limb_t *y, size_t n) {
+    auto kernel = CpuDispatch::kernels().sub_n;
+    if (kernel == CpuDispatch::sub_n_generic) {
+        return CpuDispatch::sub_n_generic(out, x, y, n);
+    }
+    return kernel(out, x, y, n);
+}
+
+
+/**
+ * @brief Row kernel out += x * y over n limbs. Runs the BMI2/ADX or portable kernel selected by CpuDispatch
+ * @param out Accumulator limbs (must not overlap x)
+ * @param x Multiplicand limbs
+ * @param n Number of limbs
+ * @param y Single limb multiplier
+ * @returns Carry limb out of the top of out
+ */
+inline UBigInt::limb_t UBigInt::addmul_1(limb_t *out, const limb_t *x, size_t n, limb_t y) {
+    auto kernel = CpuDispatch::kernels().addmul_1;
+    if (kernel == CpuDispatch::addmul_1_generic) {
+        return CpuDispatch::addmul_1_generic(out, x, n, y);
+    }
+    return kernel(out, x, n, y);
+}
+
+
+/**
+ * @brief Row kernel out -= x * y over n limbs (the multiply-subtract of division). Runs the BMI2/ADX or portable kernel selected by CpuDispatch
+ * @param out Accumulator limbs (must not overlap x)
+ * @param x Multiplicand limbs
+ * @param n Number of limbs
+ * @param y Single limb multiplier
+ * @returns Borrow limb to subtract from the limb above out
+ */
+inline UBigInt::limb_t UBigInt::submul_1(limb_t *out, const limb_t *x, size_t n, limb_t y) {
+    auto kernel = CpuDispatch::kernels().submul_1;
+    if (kernel == CpuDispatch::submul_1_generic) {
+        return CpuDispatch::submul_1_generic(out, x, n, y);
+    }
+    return kernel(out, x, n, y);
+}
+
+
+/**
+ * @brief Limb kernel out = x + y for a single limb y over n limbs; out may alias x.
+ * The carry almost always dies within a limb or two, after which the rest is a plain copy (none in place)
+ * @param out Sum limbs
+ * @param x Left hand limbs
+ * @param n Number of limbs
+ * @param y Single limb addend
+ * @returns Carry out of the top limb (0 or 1)
+ */
+inline UBigInt::limb_t UBigInt::add_1(limb_t *out, const limb_t *x, size_t n, limb_t y) {
+    size_t i = 0;
+    for (; i < n && y; i++) {
+        out[i] = x[i] + y;
+        y = out[i] < y;
+    }
+    if (out != x) {
+        std::copy(x + i, x + n, out + i);
+    }
+    return y;
+}
+
+
+/**
+ * @brief Limb kernel out = x - y for a single limb y over n limbs; out may alias x.
+ * The borrow almost always dies within a limb or two, after which the rest is a plain copy (none in place)
+ * @param out Difference limbs
+ * @param x Left hand limbs
+ * @param n Number of limbs
+ * @param y Single limb subtrahend
+ * @returns Borrow out of the top limb (0 or 1)
+ */
+inline UBigInt::limb_t UBigInt::sub_1(limb_t *out, const limb_t *x, size_t n, limb_t y) {
+    size_t i = 0;
+    for (; i < n && y; i++) {
+        limb_t cur = x[i];
+        out[i] = cur - y;
+        y = cur < y;
+    }
+    if (out != x) {
+        std::copy(x + i, x + n, out + i);
+    }
+    return y;
+}
+
+
+/**
+ * @brief Schoolbook product kernel out = x * y; out holds xn + yn limbs and must not alias the inputs
+ * @param out Product limbs
+ * @param x Left hand limbs (xn > 0)
+ * @param xn Number of left hand limbs
+ * @param y Right hand limbs (yn > 0)
+ * @param yn Number of right hand limbs
+ */
+inline void UBigInt::mul_basecase(limb_t *out, const limb_t *x, size_t xn, const limb_t *y, size_t yn) {
+    std::fill(out, out + xn, 0);
+    for (size_t j = 0; j < yn; j++) {
+        out[j+xn] = addmul_1(out + j, x, xn, y[j]);
+    }
+}
+
+
+/**
+ * @brief Schoolbook squaring kernel out = x * x; each cross product x[i]*x[j] (i < j) is computed once and doubled,
+ * roughly halving the limb products of long multiplication. out holds 2n limbs and must not alias x
+ * @param out Square limbs
+ * @param x Limbs to square
+ * @param n Number of limbs
+ */
+inline void UBigInt::sqr_basecase(limb_t *out, const limb_t *x, size_t n) {
+    std::fill(out, out + 2 * n, 0);
+    for (size_t i = 0; i + 1 < n; i++) {
+        out[i+n] = addmul_1(out + 2 * i + 1, x + i + 1, n - i - 1, x[i]);
+    }
+    limb_t top = 0;
+    for (size_t i = 0; i < 2 * n; i++) {
+        limb_t next = out[i] >> (limb_bits - 1);
+        out[i] = (out[i] << 1) | top;
+        top = next;
+    }
+    limb_t carry = 0;
+    for (size_t i = 0; i < n; i++) {
+        dlimb_t sq = static_cast<dlimb_t>(x[i]) * x[i];
+        dlimb_t sum = static_cast<dlimb_t>(out[2*i]) + static_cast<limb_t>(sq) + carry;
+        out[2*i] = static_cast<limb_t>(sum);
+        sum = static_cast<dlimb_t>(out[2*i+1]) + static_cast<limb_t>(sq >> limb_bits) + static_cast<limb_t>(sum >> limb_bits);
+        out[2*i+1] = static_cast<limb_t>(sum);
+        carry = static_cast<limb_t>(sum >> limb_bits);
+    }
+}
+
+
+/**
+ * @brief Utility method which implements core long multiplication algorithm
+ * @param lhs Left hand portion of multiplication algorithm
+ * @param rhs Right hand portion of multiplication algorithm
+ * @returns Copy of product instance
+ */
+inline UBigInt UBigInt::long_multiplication(const UBigInt &lhs, const UBigInt &rhs) {
+    if (lhs == 0 || rhs == 0) {
+        return 0;
+    }
+    const LimbVector &top = lhs.num.size() >= rhs.num.size() ? lhs.num : rhs.num;
+    const LimbVector &bottom = lhs.num.size() < rhs.num.size() ? lhs.num : rhs.num;
+    UBigInt product;
+    product.num.resize(top.size() + bottom.size());
+    mul_basecase(product.num.data(), top.data(), top.size(), bottom.data(), bottom.size());
+    product.trim();
+    return product;
+}
+
+
+/**
+ * @brief Utility method which implements schoolbook squaring; each cross product x[i]*x[j] (i < j) is computed once and doubled,
+ * roughly halving the limb products of long multiplication
+ * @param x UBigInt to square
+ * @returns Copy of square instance
+ */
+inline UBigInt UBigInt::long_square(const UBigInt &x) {
+    UBigInt product;
+    product.num.resize(2 * x.num.size());
+    sqr_basecase(product.num.data(), x.num.data(), x.num.size());
+    product.trim();
+    return product;
+}
+
+
+/**
+ * @brief Multiplication dispatcher choosing long multiplication, Karatsuba, Toom-3, Toom-4 or NTT by the size of the smaller operand.
+ * Passing the same object as both operands selects squaring, which every algorithm exploits (and passes on to its sub-products)
+ * @param lhs Left hand portion of multiplication algorithm
+ * @param rhs Right hand portion of multiplication algorithm
+ * @param thres Algorithm size thresholds (in limbs)
+ * @returns Copy of UBigInt product
+ */
+inline UBigInt UBigInt::multiply(const UBigInt &lhs, const UBigInt &rhs, const MulThresholds &thres) {
+    size_t smaller = std::min(lhs.num.size(), rhs.num.size());
+    if (smaller < std::max<size_t>(thres.karatsuba, 2)) {
+        return &lhs == &rhs ? long_square(lhs) : long_multiplication(lhs, rhs);
+    }
+    if (smaller >= thres.ntt) {
+        return ntt_multiplication(lhs, rhs);
+    }
+    if (smaller >= thres.toom4) {
+        return toom4(lhs, rhs, thres);
+    }
+    if (smaller >= thres.toom3) {
+        return toom3(lhs, rhs, thres);
+    }
+    return karatsuba(lhs, rhs, thres);
+}
+
+
+/**
+ * @brief Karatsuba recursive multiplication algorithm. Recurses on O(1) views of the operand halves and writes every
+ * sub-product straight into the result or into one scratch buffer sized up front, so the recursion itself never allocates
+ * @param lhs Left hand portion of multiplication algorithm
+ * @param rhs Right hand portion of multiplication algorithm
+ * @param thres Algorithm size thresholds (in limbs)
+ * @returns Copy of UBigInt product
+ */
+inline UBigInt UBigInt::karatsuba(const UBigInt &lhs, const UBigInt &rhs, const MulThresholds &thres) {
+    LimbVector scratch{MemoryScope::scratch()};
+    scratch.resize(karatsuba_scratch_size(std::max(lhs.num.size(), rhs.num.size()), thres, ParallelScope::depth()));
+    UBigInt product;
+    product.num.resize(lhs.num.size() + rhs.num.size());
+    karatsuba_kernel(product.num.data(), lhs.view(), rhs.view(), scratch.data(), thres);
+    product.trim();
+    return product;
+}
+
+
+/**
+ * @brief Scratch limbs karatsuba_kernel needs for operands of at most n limbs: 6h+1 limbs per recursion level of half size h,
+ * plus a separate region for each of the three sub-products on levels that run them in parallel
+ * @param n Number of limbs of the larger operand
+ * @param thres Algorithm size thresholds (in limbs)
+ * @param depth Number of parallel recursion levels left (ParallelScope::depth())
+ * @returns Number of scratch limbs
+ */
+inline size_t UBigInt::karatsuba_scratch_size(size_t n, const MulThresholds &thres, size_t depth) {
+    if (n < std::max<size_t>(thres.karatsuba, 2)) {
+        return 0;
+    }
+    size_t h = (n + 1) / 2;
+    if (depth > 0 && n >= thres.parallel) {
+        return 6 * h + 1 + 3 * karatsuba_scratch_size(h, thres, depth - 1);
+    }
+    return 6 * h + 1 + karatsuba_scratch_size(h, thres, depth);
+}
+
+
+/**
+ * @brief Karatsuba kernel out = lhs * rhs with the subtractive middle product z1 = z0 + z2 - (x0 - x1)(y0 - y1).
+ * z0 and z2 are computed in place in the low and high part of out; identical views select squaring throughout
+ * @param out Product limbs (lhs.size() + rhs.size()); must not alias the operands or scratch
+ * @param lhs Left hand limbs
+ * @param rhs Right hand limbs
+ * @param scratch At least karatsuba_scratch_size(max operand size, thres, ParallelScope::depth()) limbs
+ * @param thres Algorithm size thresholds (in limbs)
+ */
+inline void UBigInt::karatsuba_kernel(limb_t *out, UBigIntView lhs, UBigIntView rhs, limb_t *scratch, const MulThresholds &thres) {
+    if (lhs.size() < rhs.size()) {
+        std::swap(lhs, rhs);
+    }
+    size_t xn = lhs.size(), yn = rhs.size();
+    bool squaring = lhs.data() == rhs.data() && xn == yn;
+    if (yn == 0) {
+        std::fill(out, out + xn, 0);
+        return;
+    }
+    if (yn < std::max<size_t>(thres.karatsuba, 2)) {
+        if (squaring) {
+            sqr_basecase(out, lhs.data(), xn);
+        }
+        else {
+            mul_basecase(out, lhs.data(), xn, rhs.data(), yn);
+        }
+        return;
+    }
+    size_t h = (xn + 1) / 2;
+    auto product_into = [&thres](limb_t *dst, size_t size, UBigIntView a, UBigIntView b, limb_t *free) {
+        if (a.empty() || b.empty()) {
+            std::fill(dst, dst + size, 0);
+            return;
+        }
+        karatsuba_kernel(dst, a, b, free, thres);
+        std::fill(dst + a.size() + b.size(), dst + size, 0);
+    };
+    UBigIntView x0 = lhs.slice(0, h), x1 = lhs.slice(h, xn);
+    UBigIntView y0 = rhs.slice(0, h), y1 = rhs.slice(h, yn);
+    limb_t *dx = scratch, *dy = scratch + h, *t = scratch + 2 * h, *z1 = scratch + 4 * h, *free = scratch + 6 * h + 1;
+    bool dx_neg = subtract_abs(dx, x0, x1, h);
+    bool dy_neg = dx_neg;
+    UBigIntView dxv = UBigIntView(dx, h).trimmed(), dyv = dxv;
+    if (!squaring) {
+        dy_neg = subtract_abs(dy, y0, y1, h);
+        dyv = UBigIntView(dy, h).trimmed();
+    }
+
+    // z0, z2 and t write disjoint limbs; in parallel each also recurses in a scratch region of its own
+    size_t depth = ParallelScope::depth();
+    if (depth > 0 && xn >= thres.parallel) {
+        size_t branch = karatsuba_scratch_size(h, thres, depth - 1);
+        parallel_for(3, [&](size_t i) {
+            if (i == 0) {
+                product_into(out, 2 * h, x0, y0, free);
+            }
+            else if (i == 1) {
+                product_into(out + 2 * h, xn + yn - 2 * h, x1, y1, free + branch);
+            }
+            else {
+                product_into(t, 2 * h, dxv, dyv, free + 2 * branch);
+            }
+        });
+    }
+    else {
+        product_into(out, 2 * h, x0, y0, free);
+        product_into(out + 2 * h, xn + yn - 2 * h, x1, y1, free);
+        product_into(t, 2 * h, dxv, dyv, free);
+    }
+
+    // z1 = z0 + z2 -/+ |x0 - x1||y0 - y1|, then out += z1 << h
+    size_t z2_size = xn + yn - 2 * h;
+    std::copy(out, out + 2 * h, z1);
+    z1[2 * h] = 0;
+    limb_t carry = add_n(z1, z1, out + 2 * h, z2_size);
+    add_1(z1 + z2_size, z1 + z2_size, 2 * h + 1 - z2_size, carry);
+    if (dx_neg == dy_neg) {
+        z1[2 * h] -= sub_n(z1, z1, t, 2 * h);
+    }
+    else {
+        z1[2 * h] += add_n(z1, z1, t, 2 * h);
+    }
+    size_t z1_size = std::min(2 * h + 1, xn + yn - h);
+    carry = add_n(out + h, out + h, z1, z1_size);
+    add_1(out + h + z1_size, out + h + z1_size, xn + yn - h - z1_size, carry);
+}
+
+
+/**
+ * @brief Utility kernel out = |x - y| padded to n limbs
+ * @param out Difference limbs (n)
+ * @param x Trimmed left hand view of at most n limbs
+ * @param y Trimmed right hand view of at most n limbs
+ * @param n Number of limbs to write
+ * @returns True if x < y
+ */
+inline bool UBigInt::subtract_abs(limb_t *out, UBigIntView x, UBigIntView y, size_t n) {
+    bool neg = x.size() < y.size();
+    if (x.size() == y.size()) {
+        size_t i = x.size();
+        while (i > 0 && x[i - 1] == y[i - 1]) {
+            i--;
+        }
+        neg = i > 0 && x[i - 1] < y[i - 1];
+    }
+    if (neg) {
+        std::swap(x, y);
+    }
+    limb_t borrow = sub_n(out, x.data(), y.data(), y.size());
+    sub_1(out + y.size(), x.data() + y.size(), x.size() - y.size(), borrow);
+    std::fill(out + x.size(), out + n, 0);
+    return neg;
+}
+
+
+/**
+ * @brief Computes out[i] = lhs[i] * rhs[i] for independent sub-products, as parallel tasks under an active ParallelScope.
+ * Each task multiplies on its own thread's scratch; results cross threads through the synchronized heap
+ * @param lhs Left hand operands (an entry equal to rhs[i] selects squaring)
+ * @param rhs Right hand operands
+ * @param out Products
+ * @param count Number of sub-products
+ * @param thres Algorithm size thresholds (in limbs)
+ */
+inline void UBigInt::multiply_parts(const UBigInt *const *lhs, const UBigInt *const *rhs, UBigInt *out, size_t count, const MulThresholds &thres) {
+    if (!ParallelScope::pool() || lhs[0]->num.size() < thres.parallel) {
+        for (size_t i = 0; i < count; i++) {
+            out[i] = multiply(*lhs[i], *rhs[i], thres);
+        }
+        return;
+    }
+    std::vector<UBigInt> parts;
+    parts.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        parts.emplace_back(std::pmr::new_delete_resource());
+    }
+    parallel_for(count, [&](size_t i) {
+        MemoryScope scratch{MemoryScope::scratch()};
+        parts[i] = multiply(*lhs[i], *rhs[i], thres);
+    });
+    for (size_t i = 0; i < count; i++) {
+        out[i] = std::move(parts[i]);
+    }
+}
+
+
+/**
+ * @brief Toom-Cook 3-way multiplication; splits operands in three, evaluates at 0, 1, -1, -2, infinity and interpolates (Bodrato's sequence) from five sub-products
+ * @param lhs Left hand portion of multiplication algorithm
+ * @param rhs Right hand portion of multiplication algorithm
+ * @param thres Algorithm size thresholds (in limbs)
+ * @returns Copy of UBigInt product
+ */
+inline UBigInt UBigInt::toom3(const UBigInt &lhs, const UBigInt &rhs, const MulThresholds &thres) {
+    size_t k = (std::max(lhs.num.size(), rhs.num.size()) + 2) / 3;
+    UBigInt a0 = lhs.get_limb_slice(0, k);
+    UBigInt a1 = lhs.get_limb_slice(k, 2*k);
+    UBigInt a2 = lhs.get_limb_slice(2*k, lhs.num.size());
+    UBigInt b0 = rhs.get_limb_slice(0, k);
+    UBigInt b1 = rhs.get_limb_slice(k, 2*k);
+    UBigInt b2 = rhs.get_limb_slice(2*k, rhs.num.size());
+
+    UBigInt a_1 = a0 + a2;
+    UBigInt b_1 = b0 + b2;
+    UBigInt a_m1 = a_1;
+    UBigInt b_m1 = b_1;
+    bool a_m1_neg = false, b_m1_neg = false;
+    a_1 += a1;
+    b_1 += b1;
+    signed_add(a_m1, a_m1_neg, a1, true);
+    signed_add(b_m1, b_m1_neg, b1, true);
+    UBigInt a_m2 = a_m1;
+    UBigInt b_m2 = b_m1;
+    bool a_m2_neg = a_m1_neg, b_m2_neg = b_m1_neg;
+    signed_add(a_m2, a_m2_neg, a2, false);
+    signed_add(b_m2, b_m2_neg, b2, false);
+    a_m2.mul_add_limb(2, 0);
+    b_m2.mul_add_limb(2, 0);
+    signed_add(a_m2, a_m2_neg, a0, true);
+    signed_add(b_m2, b_m2_neg, b0, true);
+
+    bool squaring = &lhs == &rhs;
+    const UBigInt *x[5] = {&a0, &a_1, &a_m1, &a_m2, &a2};
+    const UBigInt *y[5] = {&b0, &b_1, &b_m1, &b_m2, &b2};
+    UBigInt r[5];
+    multiply_parts(x, squaring ? x : y, r, 5, thres);
+    UBigInt &r0 = r[0], &r1 = r[1], &rm1 = r[2], &rm2 = r[3], &r4 = r[4];
+    bool rm1_neg = a_m1_neg != b_m1_neg;
+    bool rm2_neg = a_m2_neg != b_m2_neg;
+
+    UBigInt r3 = std::move(rm2);
+    bool r3_neg = rm2_neg;
+    signed_add(r3, r3_neg, r1, true);
+    r3.div_limb(3);
+    UBigInt c1 = r1;
+    bool c1_neg = false;
+    signed_add(c1, c1_neg, rm1, !rm1_neg);
+    c1.div_limb(2);
+    UBigInt c2 = std::move(rm1);
+    bool c2_neg = rm1_neg;
+    signed_add(c2, c2_neg, r0, true);
+    UBigInt c3 = c2;
+    bool c3_neg = c2_neg;
+    signed_add(c3, c3_neg, r3, !r3_neg);
+    c3.div_limb(2);
+    signed_add(c3, c3_neg, r4, false);
+    signed_add(c3, c3_neg, r4, false);
+    signed_add(c2, c2_neg, c1, c1_neg);
+    signed_add(c2, c2_neg, r4, true);
+    signed_add(c1, c1_neg, c3, !c3_neg);
+
+    return r0 + c1.shift_limbs(k) + c2.shift_limbs(2*k) + c3.shift_limbs(3*k) + r4.shift_limbs(4*k);
+}
+
+
+/**
+ * @brief Toom-Cook 4-way multiplication; splits operands in four, evaluates at 0, 1, -1, 2, -2, 1/2, infinity and interpolates from seven sub-products
+ * @param lhs Left hand portion of multiplication algorithm
+ * @param rhs Right hand portion of multiplication algorithm
+ * @param thres Algorithm size thresholds (in limbs)
+ * @returns Copy of UBigInt product
+ */
+inline UBigInt UBigInt::toom4(const UBigInt &lhs, const UBigInt &rhs, const MulThresholds &thres) {
+    size_t k = (std::max(lhs.num.size(), rhs.num.size()) + 3) / 4;
+    UBigInt va[7], vb[7], r[7];
+    bool va_neg[7], vb_neg[7], r_neg[7];
+    bool squaring = &lhs == &rhs;
+    toom4_evaluate(lhs, k, va, va_neg);
+    if (!squaring) {
+        toom4_evaluate(rhs, k, vb, vb_neg);
+    }
+    const UBigInt *x[7], *y[7];
+    for (int i = 0; i < 7; i++) {
+        x[i] = &va[i];
+        y[i] = squaring ? &va[i] : &vb[i];
+        r_neg[i] = !squaring && va_neg[i] != vb_neg[i];
+    }
+    multiply_parts(x, y, r, 7, thres);
+    auto times = [](UBigInt x, limb_t m) {x.mul_add_limb(m, 0); return x;};
+    const UBigInt &c0 = r[0], &c6 = r[6];
+
+    // even part from r(1) +- r(-1) and r(2) +- r(-2)
+    UBigInt e1 = r[1], o1 = r[1], e2 = r[3], o2 = r[3];
+    bool e1_neg = false, o1_neg = false, e2_neg = false, o2_neg = false;
+    signed_add(e1, e1_neg, r[2], r_neg[2]);
+    signed_add(o1, o1_neg, r[2], !r_neg[2]);
+    signed_add(e2, e2_neg, r[4], r_neg[4]);
+    signed_add(o2, o2_neg, r[4], !r_neg[4]);
+    e1.div_limb(2);
+    o1.div_limb(2);
+    e2.div_limb(2);
+    o2.div_limb(4);
+    signed_add(e1, e1_neg, c0, true);
+    signed_add(e1, e1_neg, c6, true);
+    signed_add(e2, e2_neg, c0, true);
+    signed_add(e2, e2_neg, times(c6, 64), true);
+    e2.div_limb(4);
+    UBigInt c4 = e2;
+    bool c4_neg = e2_neg;
+    signed_add(c4, c4_neg, e1, !e1_neg);
+    c4.div_limb(3);
+    UBigInt c2 = e1;
+    bool c2_neg = e1_neg;
+    signed_add(c2, c2_neg, c4, !c4_neg);
+
+    // odd part from o1 = c1+c3+c5, o2 = c1+4c3+16c5 and h = 16c1+4c3+c5 from r(1/2)
+    UBigInt h = r[5];
+    bool h_neg = false;
+    signed_add(h, h_neg, times(c0, 64), true);
+    signed_add(h, h_neg, times(c2, 16), !c2_neg);
+    signed_add(h, h_neg, times(c4, 4), !c4_neg);
+    signed_add(h, h_neg, c6, true);
+    h.div_limb(2);
+    UBigInt d = std::move(h);
+    bool d_neg = h_neg;
+    signed_add(d, d_neg, o2, !o2_neg);
+    d.div_limb(15);
+    UBigInt t = o2;
+    bool t_neg = o2_neg;
+    signed_add(t, t_neg, o1, !o1_neg);
+    t.div_limb(3);
+    UBigInt c5 = t;
+    bool c5_neg = t_neg;
+    signed_add(c5, c5_neg, o1, !o1_neg);
+    signed_add(c5, c5_neg, d, d_neg);
+    c5.div_limb(3);
+    UBigInt c3 = std::move(t);
+    bool c3_neg = t_neg;
+    signed_add(c3, c3_neg, times(c5, 5), !c5_neg);
+    UBigInt c1 = std::move(d);
+    bool c1_neg = d_neg;
+    signed_add(c1, c1_neg, c5, c5_neg);
+
+    return c0 + c1.shift_limbs(k) + c2.shift_limbs(2*k) + c3.shift_limbs(3*k) + c4.shift_limbs(4*k)
+              + c5.shift_limbs(5*k) + r[6].shift_limbs(6*k);
+}
+
+
+/**
+ * @brief Utility method evaluating the 4-piece split of x at 0, 1, -1, 2, -2, 1/2 (scaled by 8), infinity for Toom-4
+ * @param x Operand to split into pieces of k limbs
+ * @param k Piece size in limbs
+ * @param v Evaluated magnitudes
+ * @param neg Evaluated signs
+ */
+inline void UBigInt::toom4_evaluate(const UBigInt &x, size_t k, UBigInt (&v)[7], bool (&neg)[7]) {
+    UBigInt x0 = x.get_limb_slice(0, k);
+    UBigInt x1 = x.get_limb_slice(k, 2*k);
+    UBigInt x2 = x.get_limb_slice(2*k, 3*k);
+    UBigInt x3 = x.get_limb_slice(3*k, x.num.size());
+    std::fill(std::begin(neg), std::end(neg), false);
+
+    UBigInt even = x0 + x2;
+    UBigInt odd = x1 + x3;
+    v[1] = even + odd;
+    v[2] = std::move(even);
+    signed_add(v[2], neg[2], odd, true);
+
+    even = x2;
+    even.mul_add_limb(4, 0);
+    even += x0;
+    odd = x3;
+    odd.mul_add_limb(4, 0);
+    odd += x1;
+    odd.mul_add_limb(2, 0);
+    v[3] = even + odd;
+    v[4] = std::move(even);
+    signed_add(v[4], neg[4], odd, true);
+
+    v[5] = x0;
+    v[5].mul_add_limb(2, 0);
+    v[5] += x1;
+    v[5].mul_add_limb(2, 0);
+    v[5] += x2;
+    v[5].mul_add_limb(2, 0);
+    v[5] += x3;
+
+    v[0] = std::move(x0);
+    v[6] = std::move(x3);
+}
+
+
+/**
+ * @brief Utility method adding a signed value to a signed magnitude in place (Toom-Cook evaluation/interpolation)
+ * @param a Magnitude accumulated into
+ * @param a_neg Sign of a (updated)
+ * @param b Magnitude added
+ * @param b_neg Sign of b
+ */
+inline void UBigInt::signed_add(UBigInt &a, bool &a_neg, const UBigInt &b, bool b_neg) {
+    if (a_neg == b_neg) {
+        a += b;
+    }
+    else if (compare(a, b) >= 0) {
+        a.subtract(b);
+    }
+    else {
+        a.subtract_from(b);
+        a_neg = b_neg;
+    }
+    if (a.num.empty()) {
+        a_neg = false;
+    }
+}
+
+
+/**
+ * @brief Utility method adding a signed product to a signed magnitude in place (a +/-= lhs*rhs).
+ * Below the Karatsuba threshold the product rows are accumulated straight into a's limbs instead of being materialized;
+ * a difference that crosses zero is detected by the final borrow and negated in place
+ * @param a Magnitude accumulated into (may alias lhs or rhs)
+ * @param a_neg Sign of a (updated)
+ * @param lhs Left hand factor
+ * @param rhs Right hand factor
+ * @param product_neg Sign of the product
+ * @param thres Algorithm size thresholds (in limbs)
+ */
+inline void UBigInt::signed_add_product(UBigInt &a, bool &a_neg, const UBigInt &lhs, const UBigInt &rhs, bool product_neg, const MulThresholds &thres) {
+    if (lhs.num.empty() || rhs.num.empty()) {
+        return;
+    }
+    const LimbVector &top = lhs.num.size() >= rhs.num.size() ? lhs.num : rhs.num;
+    const LimbVector &bottom = lhs.num.size() < rhs.num.size() ? lhs.num : rhs.num;
+    bool aliased = &lhs == &rhs || &a == &lhs || &a == &rhs;
+    if (aliased || bottom.size() >= std::max<size_t>(thres.karatsuba, 2)) {
+        MemoryScope scratch{MemoryScope::scratch()};
+        signed_add(a, a_neg, multiply(lhs, rhs, thres), product_neg);
+        return;
+    }
+    if (a.num.empty()) {
+        a_neg = product_neg;
+    }
+    // one spare limb so neither the carries of a sum nor the borrows of a difference run off the end
+    size_t size = std::max(a.num.size(), top.size() + bottom.size()) + 1;
+    a.num.resize(size, 0);
+    if (a_neg == product_neg) {
+        for (size_t j = 0; j < bottom.size(); j++) {
+            limb_t *row = a.num.data() + j;
+            limb_t carry = addmul_1(row, top.data(), top.size(), bottom[j]);
+            add_1(row + top.size(), row + top.size(), size - j - top.size(), carry);
+        }
+    }
+    else {
+        bool wrapped = false;
+        for (size_t j = 0; j < bottom.size(); j++) {
+            limb_t *row = a.num.data() + j;
+            limb_t borrow = submul_1(row, top.data(), top.size(), bottom[j]);
+            wrapped |= sub_1(row + top.size(), row + top.size(), size - j - top.size(), borrow) != 0;
+        }
+        if (wrapped) {
+            // a held a - product + 2^(64*size); two's complement negation leaves product - a
+            limb_t carry = 1;
+            for (auto &limb : a.num) {
+                limb = ~limb + carry;
+                carry = carry && limb == 0;
+            }
+            a_neg = !a_neg;
+        }
+    }
+    a.trim();
+    if (a.num.empty()) {
+        a_neg = false;
+    }
+}
+
+
+/**
+ * @brief Number-theoretic-transform multiplication (see Ntt); quasi-linear in the operand size
+ * @param lhs Left hand portion of multiplication algorithm
+ * @param rhs Right hand portion of multiplication algorithm
+ * @returns Copy of UBigInt product
+ */
+inline UBigInt UBigInt::ntt_multiplication(const UBigInt &lhs, const UBigInt &rhs) {
+    if (lhs == 0 || rhs == 0) {
+        return 0;
+    }
+    UBigInt product;
+    product.num.resize(lhs.num.size() + rhs.num.size());
+    Ntt::multiply(lhs.num.data(), lhs.num.size(), rhs.num.data(), rhs.num.size(), product.num.data());
+    product.trim();
+    return product;
+}
+
+
+/**
+ * @brief Division dispatcher choosing single limb, long (schoolbook), Burnikel-Ziegler or Newton reciprocal division by operand sizes
+ * @param lhs Dividend
+ * @param rhs Divisor
+ * @param quo Quotient output
+ * @param rem Remainder output
+ */
+inline void UBigInt::divide(const UBigInt &lhs, const UBigInt &rhs, UBigInt &quo, UBigInt &rem) {
+    if (rhs == 0) {
+        throw std::runtime_error("Division by zero in UBigInt division.");
+    }
+    if (lhs < rhs) {
+        quo = 0;
+        rem = lhs;
+    }
+    else if (rhs.num.size() == 1) {
+        quo = lhs;
+        rem = quo.div_limb(rhs.num[0]);
+    }
+    else if (std::min(rhs.num.size(), lhs.num.size() - rhs.num.size()) >= newton_division_thres) {
+        newton_division(lhs, rhs, quo, rem);
+    }
+    else if (rhs.num.size() >= burnikel_ziegler_thres && lhs.num.size() - rhs.num.size() >= burnikel_ziegler_offset) {
+        burnikel_ziegler(lhs, rhs, quo, rem);
+    }
+    else {
+        long_division(lhs, rhs, quo, rem);
+    }
+}
+
+
+/**
+ * @brief Utility method which implements core long division algorithm (Knuth Algorithm D).
+ * Normalizes the divisor so its top bit is set, estimates each quotient limb from the leading limbs (off by at most one after refinement)
+ * and applies it with a single multiply-subtract pass, adding the divisor back in the rare case the estimate was one too large
+ * @param lhs Dividend
+ * @param rhs Divisor (non-zero)
+ * @param quo Quotient output
+ * @param rem Remainder output
+ */
+inline void UBigInt::long_division(const UBigInt &lhs, const UBigInt &rhs, UBigInt &quo, UBigInt &rem) {
+    if (lhs < rhs) {
+        quo = 0;
+        rem = lhs;
+        return;
+    }
+    if (rhs.num.size() == 1) {
+        quo = lhs;
+        rem = quo.div_limb(rhs.num[0]);
+        return;
+    }
+    size_t n = rhs.num.size();
+    size_t m = lhs.num.size() - n;
+    long shift = __builtin_clzll(rhs.num.back());
+    UBigInt v = rhs;
+    UBigInt u = lhs;
+    v.shift_bits(shift);
+    u.shift_bits(shift);
+    u.num.resize(lhs.num.size() + 1);
+    const limb_t v_top = v.num[n - 1];
+    const limb_t v_next = v.num[n - 2];
+
+    UBigInt sol;
+    sol.num.assign(m + 1, 0);
+    for (size_t j = m + 1; j-- > 0;) {
+        dlimb_t top = (static_cast<dlimb_t>(u.num[j + n]) << limb_bits) | u.num[j + n - 1];
+        dlimb_t qhat = top / v_top;
+        dlimb_t rhat = top % v_top;
+        while (qhat >> limb_bits || qhat * v_next > ((rhat << limb_bits) | u.num[j + n - 2])) {
+            qhat--;
+            rhat += v_top;
+            if (rhat >> limb_bits) {
+                break;
+            }
+        }
+
+        limb_t borrow = submul_1(u.num.data() + j, v.num.data(), n, static_cast<limb_t>(qhat));
+        limb_t cur = u.num[j + n];
+        u.num[j + n] = cur - borrow;
+
+        if (cur < borrow) {
+            qhat--;
+            u.num[j + n] += add_n(u.num.data() + j, u.num.data() + j, v.num.data(), n);
+        }
+        sol.num[j] = static_cast<limb_t>(qhat);
+    }
+    sol.trim();
+    u.num.resize(n);
+    u.trim();
+    quo = std::move(sol);
+    rem = std::move(u.shift_bits(-shift));
+}
+
+
+/**
+ * @brief Burnikel-Ziegler recursive division; reduces division to multiplications so large divisions inherit Karatsuba/Toom/NTT speed.
+ * Pads the divisor to n = j*2^k limbs with its top bit set, then divides the dividend n limbs at a time with divide_2n1n
+ * @param lhs Dividend
+ * @param rhs Divisor (at least 2 limbs)
+ * @param quo Quotient output
+ * @param rem Remainder output
+ */
+inline void UBigInt::burnikel_ziegler(const UBigInt &lhs, const UBigInt &rhs, UBigInt &quo, UBigInt &rem) {
+    size_t blocks = 1;
+    while (blocks * burnikel_ziegler_thres <= rhs.num.size()) {
+        blocks *= 2;
+    }
+    size_t n = (rhs.num.size() + blocks - 1) / blocks * blocks;
+    long sigma = static_cast<long>(n * limb_bits - rhs.get_bit_length());
+    UBigInt b = rhs;
+    UBigInt a = lhs;
+    b.shift_bits(sigma);
+    a.shift_bits(sigma);
+    // t blocks of n limbs hold a plus one spare bit, so the top block is below b
+    size_t t = std::max<size_t>(2, (a.get_bit_length() + n * limb_bits) / (n * limb_bits));
+
+    UBigInt z = a.get_limb_slice((t - 2) * n, t * n);
+    UBigInt qi, ri;
+    UBigInt sol;
+    sol.num.assign((t - 1) * n, 0);
+    for (size_t i = t - 1; i-- > 0;) {
+        divide_2n1n(z, b, n, qi, ri);
+        std::copy(qi.num.begin(), qi.num.end(), sol.num.begin() + i * n);
+        if (i > 0) {
+            z = a.get_limb_slice((i - 1) * n, i * n) + ri.shift_limbs(n);
+        }
+    }
+    sol.trim();
+    quo = std::move(sol);
+    rem = std::move(ri.shift_bits(-sigma));
+}
+
+
+/**
+ * @brief Burnikel-Ziegler step dividing a 2n limb number by an n limb normalized divisor via two 3n/2n steps; falls back to long division when n is odd or small
+ * @param a Dividend, a < b * 2^(64*n)
+ * @param b Divisor of exactly n limbs with its top bit set
+ * @param n Number of limbs of b
+ * @param quo Quotient output (at most n limbs)
+ * @param rem Remainder output
+ */
+inline void UBigInt::divide_2n1n(const UBigInt &a, const UBigInt &b, size_t n, UBigInt &quo, UBigInt &rem) {
+    if (n % 2 || n < burnikel_ziegler_thres) {
+        long_division(a, b, quo, rem);
+        return;
+    }
+    size_t h = n / 2;
+    UBigInt q1, r1;
+    divide_3n2n(a.get_limb_slice(h, a.num.size()), b, h, q1, r1);
+    divide_3n2n(a.get_limb_slice(0, h) + r1.shift_limbs(h), b, h, quo, rem);
+    quo += q1.shift_limbs(h);
+}
+
+
+/**
+ * @brief Burnikel-Ziegler step dividing a 3h limb number by a 2h limb normalized divisor; estimates the quotient from the top halves then corrects at most twice
+ * @param a Dividend [a1, a2, a3] of h limb pieces, a < b * 2^(64*h)
+ * @param b Divisor [b1, b2] of exactly 2h limbs with its top bit set
+ * @param h Half the number of limbs of b
+ * @param quo Quotient output (at most h limbs)
+ * @param rem Remainder output
+ */
+inline void UBigInt::divide_3n2n(const UBigInt &a, const UBigInt &b, size_t h, UBigInt &quo, UBigInt &rem) {
+    UBigInt a12 = a.get_limb_slice(h, a.num.size());
+    UBigInt b1 = b.get_limb_slice(h, b.num.size());
+    UBigInt b2 = b.get_limb_slice(0, h);
+    UBigInt d;
+    if (a.get_limb_slice(2 * h, a.num.size()) < b1) {
+        divide_2n1n(a12, b1, h, quo, rem);
+        d = multiply(quo, b2, MulThresholds{});
+    }
+    else {
+        quo.num.assign(h, ~limb_t{0});
+        rem = a12 + b1;
+        rem -= UBigInt(b1).shift_limbs(h);
+        d = UBigInt(b2).shift_limbs(h) - b2;
+    }
+    rem = rem.shift_limbs(h) + a.get_limb_slice(0, h);
+    while (rem < d) {
+        rem += b;
+        --quo;
+    }
+    rem -= d;
+}
+
+
+/**
+ * @brief Division by multiplication with a Newton-iterated reciprocal; costs a small constant times a multiplication of the operand sizes.
+ * When the quotient is shorter than the divisor only the leading quotient-length limbs of both operands take part in the estimate,
+ * which is then corrected against the full operands
+ * @param lhs Dividend
+ * @param rhs Divisor (at least 2 limbs)
+ * @param quo Quotient output
+ * @param rem Remainder output
+ */
+inline void UBigInt::newton_division(const UBigInt &lhs, const UBigInt &rhs, UBigInt &quo, UBigInt &rem) {
+    size_t quotient_limbs = lhs.num.size() - rhs.num.size() + 1;
+    size_t drop = rhs.num.size() > quotient_limbs + 1 ? rhs.num.size() - quotient_limbs - 1 : 0;
+    UBigInt a = lhs.get_limb_slice(drop, lhs.num.size());
+    UBigInt b = rhs.get_limb_slice(drop, rhs.num.size());
+    long sigma = static_cast<long>(b.num.size() * limb_bits - b.get_bit_length());
+    a.shift_bits(sigma);
+    b.shift_bits(sigma);
+
+    // divide a block of n limbs at a time; x is within a few units of B^2n / b so each block estimate is off by at most a few units
+    size_t n = b.num.size();
+    UBigInt x = reciprocal(b);
+    size_t blocks = (a.num.size() + n - 1) / n;
+    UBigInt r;
+    UBigInt sol;
+    sol.num.assign(blocks * n, 0);
+    for (size_t i = blocks; i-- > 0;) {
+        UBigInt z = a.get_limb_slice(i * n, (i + 1) * n) + r.shift_limbs(n);
+        UBigInt qi = multiply(z.get_limb_slice(n - 1, z.num.size()), x, MulThresholds{}).get_limb_slice(n + 1, 3 * n + 2);
+        UBigInt p = multiply(qi, b, MulThresholds{});
+        while (p > z) {
+            --qi;
+            p -= b;
+        }
+        r = z - p;
+        while (r >= b) {
+            ++qi;
+            r -= b;
+        }
+        std::copy(qi.num.begin(), qi.num.end(), sol.num.begin() + i * n);
+    }
+    sol.trim();
+    if (drop == 0) {
+        quo = std::move(sol);
+        rem = std::move(r.shift_bits(-sigma));
+        return;
+    }
+    UBigInt p = multiply(sol, rhs, MulThresholds{});
+    while (p > lhs) {
+        --sol;
+        p -= rhs;
+    }
+    rem = lhs - p;
+    while (rem >= rhs) {
+        ++sol;
+        rem -= rhs;
+    }
+    quo = std::move(sol);
+}
+
+
+/**
+ * @brief Newton iteration for the reciprocal of a normalized k limb number; the reciprocal of the leading half is refined by one Newton step,
+ * doubling its precision. The step works against the full v so truncation errors do not accumulate across levels
+ * @param v Number of k limbs with its top bit set
+ * @returns B^2k / v with B = 2^64, within a few units
+ */
+inline UBigInt UBigInt::reciprocal(const UBigInt &v) {
+    size_t k = v.num.size();
+    if (k <= newton_reciprocal_base) {
+        UBigInt power, quo, rem;
+        power.num.assign(2 * k, 0);
+        power.num.push_back(1);
+        if (k >= burnikel_ziegler_thres) {
+            burnikel_ziegler(power, v, quo, rem);
+        }
+        else {
+            long_division(power, v, quo, rem);
+        }
+        return quo;
+    }
+    size_t h = (k + 1) / 2;
+    UBigInt xh = reciprocal(v.get_limb_slice(k - h, k));
+    UBigInt x = xh;
+    x.shift_limbs(k - h);
+    // x += xh * (B^(k+h) - v * xh) / B^2h; only the leading limbs of the error term contribute more than a unit
+    UBigInt power;
+    power.num.assign(k + h, 0);
+    power.num.push_back(1);
+    UBigInt vx = multiply(v, xh, MulThresholds{});
+    size_t drop = k - h - 1;
+    if (vx <= power) {
+        x += multiply(xh, (power - vx).get_limb_slice(drop, k + h + 1), MulThresholds{}).get_limb_slice(2 * h - drop, 3 * k + 2);
+    }
+    else {
+        x -= multiply(xh, (vx - power).get_limb_slice(drop, k + h + 1), MulThresholds{}).get_limb_slice(2 * h - drop, 3 * k + 2) + 1;
+    }
+    return x;
+}
+
+
+/**
+ * @brief  Randomizes UBigInt instance sign and magnitude to specified number of digits
+ * @param length Specified number of digits
+ * @returns Reference to modified UBigInt
+ */
+inline UBigInt& UBigInt::randomize(const size_t &length) {
+    std::srand(std::time(nullptr));
+    std::vector<int> va(length);
+    std::generate(va.begin(), va.end(), [](){return std::rand() % 10;});
+    *this = UBigInt{va.begin(), va.end()};
+    return *this;
+}
+
+
+/**
+ * @brief  Utility method to extract slice of the decimal representation from a start to end digit index (most significant digit first)
+ * @param  start_index Index of the beginning of the chunk to extract.
+ * @param  end_index Index of the end of the chunk to extract.
+ * @returns copy of extracted UBigInt
+ */
+inline UBigInt UBigInt::get_slice(size_t start_index, size_t end_index) const {
+    std::string s = to_string();
+    start_index = std::min(start_index, s.size());
+    end_index = std::min(std::max(start_index, end_index), s.size());
+    return UBigInt(s.substr(start_index, end_index - start_index));
+}
+
+
+/**
+ * @brief  Utility method to extract slice of limbs from a start to end limb index (least significant limb first)
+ * @param  start_index Index of the first limb to extract.
+ * @param  end_index Index one past the last limb to extract.
+ * @returns copy of extracted UBigInt
+ */
+inline UBigInt UBigInt::get_limb_slice(size_t start_index, size_t end_index) const {
+    UBigInt slice;
+    end_index = std::min(end_index, num.size());
+    if (start_index < end_index) {
+        slice.num.assign(num.begin() + start_index, num.begin() + end_index);
+        slice.trim();
+    }
+    return slice;
+}
+
+
+/**
+ * @brief  Utility method which shifts up by m whole limbs (multiplies by 2^(64*m))
+ * @param m Number of limbs to shift forward
+ * @returns Reference to modified UBigInt
+ */
+inline UBigInt& UBigInt::shift_limbs(size_t m) {
+    if (!num.empty() && m > 0) {
+        num.insert(num.begin(), m, 0);
+    }
+    return *this;
+}
+
+
+/**
+ * @brief  Utility method which shifts by m bits; multiplies (m > 0) or floor divides (m < 0) by 2^|m|
+ * @param m Number of bits to shift forward or back
+ * @returns Reference to modified UBigInt
+ */
+inline UBigInt& UBigInt::shift_bits(long m) {
+    return m >= 0 ? *this <<= static_cast<size_t>(m) : *this >>= static_cast<size_t>(-m);
+}
+
+
+/**
+ * @brief Utility method testing whether any of the m least significant bits is set (i.e. whether >> m discards a nonzero part)
+ * @param m Number of low bits
+ * @returns True if *this mod 2^m != 0
+ */
+inline bool UBigInt::any_bit_below(size_t m) const {
+    size_t limbs = std::min(m / limb_bits, num.size());
+    if (std::any_of(num.begin(), num.begin() + limbs, [](limb_t limb) {return limb != 0;})) {
+        return true;
+    }
+    return limbs < num.size() && (num[limbs] & ((limb_t(1) << (m % limb_bits)) - 1)) != 0;
+}
+
+
+/**
+ * @brief Overloaded UBigInt left shift assignment operator; multiplies by 2^m in a single pass over the limbs
+ * @param m Number of bits to shift by
+ * @returns Reference to modified instance
+ */
+inline UBigInt& UBigInt::operator<<=(size_t m) {
+    if (num.empty() || m == 0) {
+        return *this;
+    }
+    size_t limbs = m / limb_bits;
+    int bits = m % limb_bits;
+    size_t n = num.size();
+    num.resize(n + limbs + 1, 0);
+    limb_t *p = num.data();
+    if (bits) {
+        // from the top down so every limb is read before it is overwritten
+        p[n + limbs] = p[n - 1] >> (limb_bits - bits);
+        for (size_t i = n - 1; i > 0; i--) {
+            p[i + limbs] = (p[i] << bits) | (p[i - 1] >> (limb_bits - bits));
+        }
+        p[limbs] = p[0] << bits;
+    }
+    else {
+        std::copy_backward(p, p + n, p + n + limbs);
+    }
+    std::fill(p, p + limbs, 0);
+    trim();
+    return *this;
+}
+
+
+/**
+ * @brief Overloaded UBigInt right shift assignment operator; floor divides by 2^m in a single pass over the limbs
+ * @param m Number of bits to shift by
+ * @returns Reference to modified instance
+ */
+inline UBigInt& UBigInt::operator>>=(size_t m) {
+    size_t limbs = m / limb_bits;
+    int bits = m % limb_bits;
+    if (limbs >= num.size()) {
+        num.clear();
+        return *this;
+    }
+    size_t n = num.size() - limbs;
+    limb_t *p = num.data();
+    if (bits) {
+        for (size_t i = 0; i + 1 < n; i++) {
+            p[i] = (p[i + limbs] >> bits) | (p[i + limbs + 1] << (limb_bits - bits));
+        }
+        p[n - 1] = p[n - 1 + limbs] >> bits;
+    }
+    else {
+        std::copy(p + limbs, p + limbs + n, p);
+    }
+    num.resize(n);
+    trim();
+    return *this;
+}
+
+
+/**
+ * @brief Overloaded UBigInt bitwise and assignment operator; limbs above the shorter operand become zero
+ * @param rhs UBigInt reference and-ed into *this
+ * @returns Reference to modified instance
+ */
+inline UBigInt& UBigInt::operator&=(const UBigInt &rhs) {
+    size_t n = std::min(num.size(), rhs.num.size());
+    num.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        num[i] &= rhs.num[i];
+    }
+    trim();
+    return *this;
+}
+
+
+/**
+ * @brief Overloaded UBigInt bitwise or assignment operator
+ * @param rhs UBigInt reference or-ed into *this
+ * @returns Reference to modified instance
+ */
+inline UBigInt& UBigInt::operator|=(const UBigInt &rhs) {
+    size_t n = rhs.num.size();
+    if (num.size() < n) {
+        num.resize(n, 0);
+    }
+    for (size_t i = 0; i < n; i++) {
+        num[i] |= rhs.num[i];
+    }
+    return *this;
+}
+
+
+/**
+ * @brief Overloaded UBigInt bitwise exclusive or assignment operator
+ * @param rhs UBigInt reference xor-ed into *this
+ * @returns Reference to modified instance
+ */
+inline UBigInt& UBigInt::operator^=(const UBigInt &rhs) {
+    size_t n = rhs.num.size();
+    if (num.size() < n) {
+        num.resize(n, 0);
+    }
+    for (size_t i = 0; i < n; i++) {
+        num[i] ^= rhs.num[i];
+    }
+    trim();
+    return *this;
+}
+
+
+/**
+ * @brief Overloaded UBigInt bitwise and operator
+ * @param lhs UBigInt reference lhs operand
+ * @param rhs UBigInt reference rhs operand
+ * @returns Copy of new instance
+ */
+inline UBigInt operator&(const UBigInt &lhs, const UBigInt &rhs) {
+    return UBigInt(lhs) & rhs;
+}
+
+
+/**
+ * @brief Overloaded UBigInt bitwise or operator
+ * @param lhs UBigInt reference lhs operand
+ * @param rhs UBigInt reference rhs operand
+ * @returns Copy of new instance
+ */
+inline UBigInt operator|(const UBigInt &lhs, const UBigInt &rhs) {
+    return UBigInt(lhs) | rhs;
+}
+
+
+/**
+ * @brief Overloaded UBigInt bitwise exclusive or operator
+ * @param lhs UBigInt reference lhs operand
+ * @param rhs UBigInt reference rhs operand
+ * @returns Copy of new instance
+ */
+inline UBigInt operator^(const UBigInt &lhs, const UBigInt &rhs) {
+    return UBigInt(lhs) ^ rhs;
+}
+
+
+/**
+ * @brief UBigInt bitwise and operator reusing the storage of a temporary lhs
+ * @param lhs UBigInt rvalue lhs operand (result is built in its storage)
+ * @param rhs UBigInt reference rhs operand
+ * @returns lhs holding the result
+ */
+inline UBigInt operator&(UBigInt &&lhs, const UBigInt &rhs) {
+    return std::move(lhs &= rhs);
+}
+
+
+/**
+ * @brief UBigInt bitwise or operator reusing the storage of a temporary lhs
+ * @param lhs UBigInt rvalue lhs operand (result is built in its storage)
+ * @param rhs UBigInt reference rhs operand
+ * @returns lhs holding the result
+ */
+inline UBigInt operator|(UBigInt &&lhs, const UBigInt &rhs) {
+    return std::move(lhs |= rhs);
+}
+
+
+/**
+ * @brief UBigInt bitwise exclusive or operator reusing the storage of a temporary lhs
+ * @param lhs UBigInt rvalue lhs operand (result is built in its storage)
+ * @param rhs UBigInt reference rhs operand
+ * @returns lhs holding the result
+ */
+inline UBigInt operator^(UBigInt &&lhs, const UBigInt &rhs) {
+    return std::move(lhs ^= rhs);
+}
+
+
+/**
+ * @brief Overloaded UBigInt left shift operator
+ * @param lhs UBigInt reference shifted
+ * @param m Number of bits to shift by
+ * @returns Copy of new instance holding lhs * 2^m
+ */
+inline UBigInt operator<<(const UBigInt &lhs, size_t m) {
+    return UBigInt(lhs) << m;
+}
+
+
+/**
+ * @brief Overloaded UBigInt right shift operator
+ * @param lhs UBigInt reference shifted
+ * @param m Number of bits to shift by
+ * @returns Copy of new instance holding floor(lhs / 2^m)
+ */
+inline UBigInt operator>>(const UBigInt &lhs, size_t m) {
+    return UBigInt(lhs) >> m;
+}
+
+
+/**
+ * @brief UBigInt left shift operator reusing the storage of a temporary lhs
+ * @param lhs UBigInt rvalue shifted (result is built in its storage)
+ * @param m Number of bits to shift by
+ * @returns lhs holding lhs * 2^m
+ */
+inline UBigInt operator<<(UBigInt &&lhs, size_t m) {
+    return std::move(lhs <<= m);
+}
+
+
+/**
+ * @brief UBigInt right shift operator reusing the storage of a temporary lhs
+ * @param lhs UBigInt rvalue shifted (result is built in its storage)
+ * @param m Number of bits to shift by
+ * @returns lhs holding floor(lhs / 2^m)
+ */
+inline UBigInt operator>>(UBigInt &&lhs, size_t m) {
+    return std::move(lhs >>= m);
+}
+
+
+/**
+ * @brief Tests a single bit
+ * @param i Bit index (0 is the least significant)
+ * @returns Value of bit i
+ */
+inline bool UBigInt::test_bit(size_t i) const {
+    size_t k = i / limb_bits;
+    return k < num.size() && ((num[k] >> (i % limb_bits)) & 1);
+}
+
+
+/**
+ * @brief Sets or clears a single bit
+ * @param i Bit index (0 is the least significant)
+ * @param value New value of bit i
+ * @returns Reference to modified instance
+ */
+inline UBigInt& UBigInt::set_bit(size_t i, bool value) {
+    size_t k = i / limb_bits;
+    limb_t bit = limb_t(1) << (i % limb_bits);
+    if (value) {
+        if (k >= num.size()) {
+            num.resize(k + 1, 0);
+        }
+        num[k] |= bit;
+    }
+    else if (k < num.size()) {
+        num[k] &= ~bit;
+        trim();
+    }
+    return *this;
+}
+
+
+/**
+ * @brief  Number of significant bits of the number
+ * @returns Position of the highest set bit plus one (0 for zero)
+ */
+inline size_t UBigInt::get_bit_length() const {
+    if (num.empty()) {
+        return 0;
+    }
+    return num.size() * limb_bits - __builtin_clzll(num.back());
+}
+
+
+/**
+ * @brief Hash of the value for unordered containers; mixes every limb with a multiply and xor-shift
+ * @returns Hash value (equal values hash equally)
+ */
+inline size_t UBigInt::hash() const {
+    std::uint64_t h = num.size();
+    for (limb_t limb : num) {
+        h = (h ^ limb) * 0x9e3779b97f4a7c15ull;
+        h ^= h >> 32;
+    }
+    return static_cast<size_t>(h);
+}
+
+
+/**
+ * @brief  Converts to the decimal representation; large values are split recursively by the cached powers 10^(19*2^k)
+ * so the conversion costs a few divisions (i.e. multiplications) per level instead of O(n^2) limb divisions
+ * @returns Decimal std::string (most significant digit first)
+ */
+inline std::string UBigInt::to_string() const {
+    if (num.empty()) {
+        return "0";
+    }
+    std::string s;
+    if (num.size() < decimal_conversion_thres) {
+        char buffer[decimal_buffer_size];
+        return std::string(buffer, write_decimal_chunks(*this, buffer, sizeof(buffer)));
+    }
+    MemoryScope scratch{MemoryScope::scratch()};
+    size_t level = 0;
+    while (!(*this < decimal_power(level))) {
+        level++;
+    }
+    write_decimal(*this, level, false, s);
+    return s;
+}
+
+
+/**
+ * @brief Divide-and-conquer decimal printing; divides by 10^(19*2^(level-1)) and prints quotient and zero padded remainder recursively
+ * @param x Value below 10^(19*2^level)
+ * @param level Level of the power bounding x
+ * @param pad Zero pad the output to 19*2^level digits
+ * @param out String the digits are appended to
+ */
+inline void UBigInt::write_decimal(const UBigInt &x, size_t level, bool pad, std::string &out) {
+    if (level == 0 || x.num.size() < decimal_conversion_thres) {
+        char buffer[decimal_buffer_size];
+        size_t length = write_decimal_chunks(x, buffer, sizeof(buffer));
+        if (pad) {
+            out.append((size_t{decimal_chunk_digits} << level) - length, '0');
+        }
+        out.append(buffer, length);
+        return;
+    }
+    if (!pad && x < decimal_power(level - 1)) {
+        write_decimal(x, level - 1, false, out);
+        return;
+    }
+    UBigInt quo, rem;
+    divide(x, decimal_power(level - 1), quo, rem);
+    write_decimal(quo, level - 1, pad, out);
+    write_decimal(rem, level - 1, true, out);
+}
+
+
+/**
+ * @brief Utility method which prints a value below decimal_conversion_thres limbs without allocating; splits it into 10^19 chunks
+ * by single limb division of a stack copy, then writes each chunk two digits at a time from a digit pair table
+ * @param x Value to print (below decimal_conversion_thres limbs)
+ * @param out Output buffer
+ * @param size Capacity of out
+ * @returns Number of characters written, 0 if they do not fit
+ */
+inline size_t UBigInt::write_decimal_chunks(const UBigInt &x, char *out, size_t size) {
+    static constexpr char digit_pairs[] = "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+    limb_t temp[decimal_conversion_thres];
+    limb_t chunks[decimal_conversion_thres + 2];
+    size_t n = x.num.size();
+    std::copy(x.num.begin(), x.num.end(), temp);
+    size_t count = 0;
+    while (n > 0) {
+        limb_t rem = 0;
+        for (size_t i = n; i-- > 0;) {
+            dlimb_t cur = (static_cast<dlimb_t>(rem) << limb_bits) | temp[i];
+            temp[i] = static_cast<limb_t>(cur / decimal_chunk);
+            rem = static_cast<limb_t>(cur % decimal_chunk);
+        }
+        chunks[count++] = rem;
+        while (n > 0 && temp[n - 1] == 0) {
+            n--;
+        }
+    }
+
+    size_t lead = 0;
+    for (limb_t v = count ? chunks[count - 1] : 0; v > 0; v /= 10) {
+        lead++;
+    }
+    size_t length = count ? (count - 1) * decimal_chunk_digits + lead : 1;
+    if (length > size) {
+        return 0;
+    }
+    out[0] = '0';
+    char *end = out + length;
+    for (size_t i = 0; i < count; i++) {
+        limb_t v = chunks[i];
+        size_t chunk_digits = i + 1 < count ? decimal_chunk_digits : lead;
+        for (; chunk_digits >= 2; chunk_digits -= 2, v /= 100) {
+            end -= 2;
+            std::memcpy(end, digit_pairs + 2 * (v % 100), 2);
+        }
+        if (chunk_digits) {
+            *--end = static_cast<char>('0' + v);
+        }
+    }
+    return length;
+}
+
+
+/**
+ * @brief  Number of decimal digits of the number in O(1): log10 is estimated from the top limb and the bit length, which decides the
+ * count unless the value lies within about 1e-12 (relative) of a power of ten. Only then is it compared exactly against that power,
+ * kept in a per-thread cache so repeated queries near the same power of ten compute it once
+ * @returns Length of decimal representation (1 for zero)
+ */
+inline size_t UBigInt::get_length() const {
+    if (num.size() <= 1) {
+        limb_t x = num.empty() ? 0 : num[0];
+        size_t digits = 1;
+        while (x >= 10) {
+            x /= 10;
+            digits++;
+        }
+        return digits;
+    }
+    // *this = top * 2^shift up to a relative error of 2^-63, with the top 64 bits normalized
+    size_t bits = get_bit_length();
+    size_t shift = bits - limb_bits;
+    int offset = static_cast<int>(shift % limb_bits);
+    size_t k = shift / limb_bits;
+    limb_t top = offset ? (num[k + 1] << (limb_bits - offset)) | (num[k] >> offset) : num[k];
+    double log10_value = std::log10(static_cast<double>(top)) + static_cast<double>(shift) * 0.30102999566398119521;
+    double whole = std::floor(log10_value);
+    double margin = 1e-12 * (log10_value + 1);
+    if (log10_value - whole > margin && whole + 1 - log10_value > margin) {
+        return static_cast<size_t>(whole) + 1;
+    }
+    // close to 10^estimate: *this has estimate digits if below it, estimate + 1 otherwise
+    size_t estimate = static_cast<size_t>(std::llround(log10_value));
+    static thread_local std::pair<size_t, UBigInt> cached{0, UBigInt(std::pmr::new_delete_resource())};
+    if (cached.first != estimate || cached.second.num.empty()) {
+        cached.first = estimate;
+        cached.second = pow(UBigInt(10), static_cast<std::uint64_t>(estimate));
+    }
+    return *this < cached.second ? estimate : estimate + 1;
+}
+
+
+/**
+ * @brief  UBigInt's exponent utility method (sliding window square-and-multiply)
+ * @param rhs Exponent to raise base *this by
+ * @returns Reference to modified UBigInt
+ */
+inline UBigInt& UBigInt::power(const UBigInt &rhs) {
+    MemoryScope scratch{MemoryScope::scratch()};
+    *this = window_power(*this, rhs, [](const UBigInt &a, const UBigInt &b) {return multiply(a, b, MulThresholds{});});
+    return *this;
+}
+
+
+/**
+ * @brief  Squares *this in place with the dedicated squaring algorithms
+ * @returns Reference to modified UBigInt
+ */
+inline UBigInt& UBigInt::square() {
+    MemoryScope scratch{MemoryScope::scratch()};
+    *this = multiply(*this, *this, MulThresholds{});
+    return *this;
+}
+
+
+/**
+ * @brief  UBigInt's exponent utility method for a native exponent
+ * @param rhs Exponent to raise base *this by
+ * @returns Reference to modified UBigInt
+ */
+inline UBigInt& UBigInt::power(std::uint64_t rhs) {
+    return power(UBigInt{rhs});
+}
+
+
+/**
+ * @brief Raises base to exp without modifying base
+ * @param base UBigInt reference to raise
+ * @param exp Exponent
+ * @returns Copy of new instance holding base^exp
+ */
+inline UBigInt pow(const UBigInt &base, const UBigInt &exp) {
+    return UBigInt(base).power(exp);
+}
+
+
+/**
+ * @brief Raises base to a native exponent without modifying base
+ * @param base UBigInt reference to raise
+ * @param exp Exponent
+ * @returns Copy of new instance holding base^exp
+ */
+inline UBigInt pow(const UBigInt &base, std::uint64_t exp) {
+    return UBigInt(base).power(exp);
+}
+
+
+/**
+ * @brief Left-to-right sliding window exponentiation; scans exp from its top bit, squaring once per bit and multiplying by a
+ * precomputed odd power of base once per window, so base^exp costs about log2(exp) squarings plus log2(exp)/(window+1) multiplications
+ * @param base Base
+ * @param exp Exponent (non-zero)
+ * @param mul Callable (const UBigInt&, const UBigInt&) -> UBigInt defining the product (plain, reduced or Montgomery)
+ * @returns base^exp under mul
+ */
+template <typename Mul>
+inline UBigInt UBigInt::window_power(const UBigInt &base, const UBigInt &exp, Mul mul) {
+    size_t bits = exp.get_bit_length();
+    if (bits == 0) {
+        return 1;
+    }
+    auto bit = [&exp](size_t i) {return (exp.num[i / limb_bits] >> (i % limb_bits)) & 1;};
+    size_t window = bits > 671 ? 5 : bits > 239 ? 4 : bits > 79 ? 3 : bits > 23 ? 2 : 1;
+
+    // odd[i] = base^(2i+1)
+    std::vector<UBigInt> odd(size_t{1} << (window - 1));
+    odd[0] = base;
+    if (odd.size() > 1) {
+        UBigInt base_sq = mul(base, base);
+        for (size_t i = 1; i < odd.size(); i++) {
+            odd[i] = mul(odd[i - 1], base_sq);
+        }
+    }
+
+    UBigInt result;
+    bool started = false;
+    for (size_t i = bits; i > 0;) {
+        if (!bit(i - 1)) {
+            result = mul(result, result);
+            i--;
+            continue;
+        }
+        size_t low = i > window ? i - window : 0;
+        while (!bit(low)) {
+            low++;
+        }
+        size_t value = 0;
+        for (size_t j = i; j-- > low;) {
+            value = (value << 1) | bit(j);
+        }
+        if (started) {
+            for (size_t j = low; j < i; j++) {
+                result = mul(result, result);
+            }
+            result = mul(result, odd[value >> 1]);
+        }
+        else {
+            result = odd[value >> 1];
+            started = true;
+        }
+        i = low;
+    }
+    return result;
+}
+
+
+/**
+ * @brief Modular exponentiation without materializing base^exp; Montgomery multiplication for odd moduli, multiply-and-reduce otherwise
+ * @param base UBigInt reference to raise
+ * @param exp Exponent
+ * @param mod Modulus (non-zero)
+ * @returns base^exp mod mod
+ */
+inline UBigInt powmod(const UBigInt &base, const UBigInt &exp, const UBigInt &mod) {
+    if (mod == 0) {
+        throw std::runtime_error("Division by zero in UBigInt powmod.");
+    }
+    UBigInt result;
+    MemoryScope scratch{MemoryScope::scratch()};
+    if (mod == 1) {
+        result = 0;
+    }
+    else if (exp == 0) {
+        result = 1;
+    }
+    else if (mod.num[0] & 1) {
+        // Montgomery form x*R mod m with R = 2^(64*n); multiplying by 1 at the end converts back
+        size_t n = mod.num.size();
+        UBigInt::limb_t m_inv = UBigInt::montgomery_inverse(mod.num[0]);
+        UBigInt base_r = base % mod;
+        base_r.shift_limbs(n);
+        auto mont = [&mod, m_inv](const UBigInt &a, const UBigInt &b) {return UBigInt::montgomery_multiply(a, b, mod, m_inv);};
+        result = mont(UBigInt::window_power(base_r % mod, exp, mont), 1);
+    }
+    else {
+        auto reduce = [&mod](const UBigInt &a, const UBigInt &b) {return UBigInt::multiply(a, b, MulThresholds{}) % mod;};
+        result = UBigInt::window_power(base % mod, exp, reduce);
+    }
+    return result;
+}
+
+
+/**
+ * @brief Computes -m0^-1 mod 2^64 by Newton iteration (each step doubles the number of correct bits)
+ * @param m0 Least significant limb of an odd modulus
+ * @returns Montgomery reduction constant
+ */
+inline UBigInt::limb_t UBigInt::montgomery_inverse(limb_t m0) {
+    limb_t inv = m0;
+    for (int i = 0; i < 6; i++) {
+        inv *= 2 - m0 * inv;
+    }
+    return 0 - inv;
+}
+
+
+/**
+ * @brief Montgomery product (coarsely integrated operand scanning); interleaves each limb of a*b with one limb of reduction.
+ * Squares (a aliases b) are instead computed with the squaring algorithms and reduced separately
+ * @param a Factor below m
+ * @param b Factor below m
+ * @param m Odd modulus of n limbs
+ * @param m_inv -m^-1 mod 2^64
+ * @returns a*b*2^(-64n) mod m
+ */
+inline UBigInt UBigInt::montgomery_multiply(const UBigInt &a, const UBigInt &b, const UBigInt &m, limb_t m_inv) {
+    if (&a == &b) {
+        return montgomery_reduce(multiply(a, a, MulThresholds{}), m, m_inv);
+    }
+    size_t n = m.num.size();
+    UBigInt t;
+    t.num.assign(n + 2, 0);
+    for (size_t i = 0; i < n; i++) {
+        limb_t ai = i < a.num.size() ? a.num[i] : 0;
+        limb_t carry = 0;
+        for (size_t j = 0; j < b.num.size(); j++) {
+            dlimb_t cur = static_cast<dlimb_t>(ai) * b.num[j] + t.num[j] + carry;
+            t.num[j] = static_cast<limb_t>(cur);
+            carry = static_cast<limb_t>(cur >> limb_bits);
+        }
+        for (size_t j = b.num.size(); carry && j < n + 2; j++) {
+            t.num[j] += carry;
+            carry = t.num[j] < carry;
+        }
+
+        limb_t u = t.num[0] * m_inv;
+        dlimb_t cur = static_cast<dlimb_t>(u) * m.num[0] + t.num[0];
+        carry = static_cast<limb_t>(cur >> limb_bits);
+        for (size_t j = 1; j < n; j++) {
+            cur = static_cast<dlimb_t>(u) * m.num[j] + t.num[j] + carry;
+            t.num[j - 1] = static_cast<limb_t>(cur);
+            carry = static_cast<limb_t>(cur >> limb_bits);
+        }
+        cur = static_cast<dlimb_t>(t.num[n]) + carry;
+        t.num[n - 1] = static_cast<limb_t>(cur);
+        t.num[n] = t.num[n + 1] + static_cast<limb_t>(cur >> limb_bits);
+        t.num[n + 1] = 0;
+    }
+    t.trim();
+    if (t >= m) {
+        t -= m;
+    }
+    return t;
+}
+
+
+/**
+ * @brief Montgomery reduction (REDC) of a full product; clears one low limb per step by adding a multiple of m
+ * @param t Product below m * 2^(64n)
+ * @param m Odd modulus of n limbs
+ * @param m_inv -m^-1 mod 2^64
+ * @returns t*2^(-64n) mod m
+ */
+inline UBigInt UBigInt::montgomery_reduce(UBigInt t, const UBigInt &m, limb_t m_inv) {
+    size_t n = m.num.size();
+    t.num.resize(2 * n + 1);
+    for (size_t i = 0; i < n; i++) {
+        limb_t u = t.num[i] * m_inv;
+        limb_t carry = 0;
+        for (size_t j = 0; j < n; j++) {
+            dlimb_t cur = static_cast<dlimb_t>(u) * m.num[j] + t.num[i+j] + carry;
+            t.num[i+j] = static_cast<limb_t>(cur);
+            carry = static_cast<limb_t>(cur >> limb_bits);
+        }
+        for (size_t j = i + n; carry; j++) {
+            t.num[j] += carry;
+            carry = t.num[j] < carry;
+        }
+    }
+    t = t.get_limb_slice(n, 2 * n + 1);
+    if (t >= m) {
+        t -= m;
+    }
+    return t;
+}
+
+
+/**
+ * @brief  UBigInt's base-10 shift utility method; multiplies (m > 0) or divides (m < 0) by 10^|m|
+ * @param m Number of places to shift forward or back
+ * @returns Reference to modified UBigInt
+ */
+inline UBigInt& UBigInt::shift10(int m) {
+    while (m > 0) {
+        int step = std::min(m, decimal_chunk_digits);
+        limb_t scale = 1;
+        for (int i = 0; i < step; i++) {
+            scale *= 10;
+        }
+        mul_add_limb(scale, 0);
+        m -= step;
+    }
+    while (m < 0 && !num.empty()) {
+        int step = std::min(-m, decimal_chunk_digits);
+        limb_t scale = 1;
+        for (int i = 0; i < step; i++) {
+            scale *= 10;
+        }
+        div_limb(scale);
+        m += step;
+    }
+    return *this;
+}
+
+
+namespace std {
+/**
+ * @brief std::hash specialization so UBigInt can key unordered containers
+ */
+template <>
+struct hash<UBigInt> {
+    size_t operator()(const UBigInt &x) const {return x.hash();}
+};
+}
+
 #endif
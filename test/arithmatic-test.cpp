@@ -1,5 +1,11 @@
 #include <gtest/gtest.h>
+#include <boost/multiprecision/gmp.hpp>
+#include <sstream>
+#include <list>
 #include "bigint.h"
+#include "expression.h"
+#include "thread_pool.h"
+#include "combinatorics.h"
 
 /**
  * @brief Unit test (gtest) for addition arithmatic
@@ -112,3 +118,642 @@ TEST (arithmatic, division_test) {
     EXPECT_EQ((tz/ta), BigInt("0"));
     EXPECT_EQ((tz/tb), BigInt("0"));
 }
+
+
+/**
+ * @brief Unit test (gtest) for remainder and divmod; remainders take the sign of the dividend
+ */
+TEST (arithmatic, remainder_test) {
+    BigInt ta("123");
+    BigInt tb("-123");
+    BigInt tc("48");
+    BigInt td("-48");
+    BigInt tz("0");
+    EXPECT_EQ((ta%tc), BigInt("27"));
+    EXPECT_EQ((ta%td), BigInt("27"));
+    EXPECT_EQ((tb%tc), BigInt("-27"));
+    EXPECT_EQ((tb%td), BigInt("-27"));
+    EXPECT_EQ((tc%ta), BigInt("48"));
+    EXPECT_EQ((td%ta), BigInt("-48"));
+    EXPECT_EQ((tz%tb), BigInt("0"));
+    EXPECT_EQ((tb%tb), BigInt("0"));
+    EXPECT_THROW(ta % tz, std::runtime_error);
+
+    BigInt te("-4009281734901283749012384721908472198472109837409123809847985685609847982356978364038976501389653019856398739");
+    BigInt tf("72046120374610239849186598742395873129058732904587320958620319483208989764043890389275");
+    auto [quo, rem] = divmod(te, tf);
+    EXPECT_EQ(quo, te / tf);
+    EXPECT_EQ(rem, te % tf);
+    EXPECT_EQ(quo * tf + rem, te);
+
+    UBigInt ua{"340282366920938463463374607431768211457"};
+    ua %= UBigInt{"18446744073709551616"};
+    EXPECT_EQ(ua, UBigInt(1));
+    auto [uq, ur] = divmod(UBigInt(1000), UBigInt(7));
+    EXPECT_EQ(uq, UBigInt(142));
+    EXPECT_EQ(ur, UBigInt(6));
+}
+
+
+/**
+ * @brief Generates a random signed decimal string with the specified number of digits
+ */
+static std::string random_decimal(size_t length) {
+    std::string s = (std::rand() % 2) ? "-" : "";
+    s.push_back((std::rand() % 9 + 1) + '0');
+    for (size_t i = 1; i < length; i++) {
+        s.push_back((std::rand() % 10) + '0');
+    }
+    return s;
+}
+
+
+/**
+ * @brief Streams a value into a std::string
+ */
+template <typename T>
+static std::string str(const T &value) {
+    std::stringstream ss;
+    ss << value;
+    return ss.str();
+}
+
+
+/**
+ * @brief Unit test (gtest) cross-checking arithmatic against GMP on random operands spanning all multiplication/division regimes
+ */
+TEST (arithmatic, gmp_crosscheck_test) {
+    using boost::multiprecision::mpz_int;
+    std::srand(12345);
+    for (size_t length : {1, 5, 19, 20, 39, 40, 100, 700, 3000}) {
+        for (int rep = 0; rep < 4; rep++) {
+            std::string s1 = random_decimal(length);
+            std::string s2 = random_decimal(std::max<size_t>(1, length / (rep + 1)));
+            BigInt a{s1}, b{s2};
+            mpz_int ga{s1}, gb{s2};
+            EXPECT_EQ(str(a + b), str(mpz_int(ga + gb)));
+            EXPECT_EQ(str(a - b), str(mpz_int(ga - gb)));
+            EXPECT_EQ(str(a * b), str(mpz_int(ga * gb)));
+            EXPECT_EQ(str(a / b), str(mpz_int(ga / gb)));
+            EXPECT_EQ(str(b / a), str(mpz_int(gb / ga)));
+            EXPECT_EQ(str(a % b), str(mpz_int(ga % gb)));
+            EXPECT_EQ(str(b % a), str(mpz_int(gb % ga)));
+        }
+    }
+}
+
+
+/**
+ * @brief Unit test (gtest) for exponentiation; window sizes 1-5 are exercised by exponents of growing bit length
+ */
+TEST (arithmatic, power_test) {
+    using boost::multiprecision::mpz_int;
+    BigInt ta("-3");
+    EXPECT_EQ(pow(ta, 0), BigInt(1));
+    EXPECT_EQ(pow(ta, 1), BigInt(-3));
+    EXPECT_EQ(pow(ta, 4), BigInt(81));
+    EXPECT_EQ(pow(ta, BigInt(5)), BigInt(-243));
+    EXPECT_EQ(pow(ta, -2), BigInt(0));
+    EXPECT_EQ(pow(BigInt(-1), -3), BigInt(-1));
+    EXPECT_EQ(pow(BigInt(0), 0), BigInt(1));
+    EXPECT_THROW(pow(BigInt(0), -1), std::runtime_error);
+    EXPECT_THROW(BigInt(0).power(BigInt(-3)), std::runtime_error);
+    EXPECT_EQ(ta, BigInt(-3));
+    EXPECT_EQ(ta.power(3), BigInt(-27));
+
+    UBigInt ua{"12345678901234567890"};
+    for (std::uint64_t exp : {2ull, 7ull, 31ull, 100ull, 300ull, 1000ull, 12345ull}) {
+        mpz_int expected = boost::multiprecision::pow(mpz_int("12345678901234567890"), static_cast<unsigned>(exp));
+        EXPECT_EQ(pow(ua, exp).to_string(), str(expected));
+        EXPECT_EQ(pow(ua, UBigInt(exp)).to_string(), str(expected));
+    }
+    EXPECT_EQ(pow(UBigInt(2), 64), UBigInt("18446744073709551616"));
+    EXPECT_EQ(UBigInt(7).power(UBigInt(0)), UBigInt(1));
+}
+
+
+/**
+ * @brief Unit test (gtest) for modular exponentiation against GMP with odd (Montgomery) and even moduli
+ */
+TEST (arithmatic, powmod_test) {
+    using boost::multiprecision::mpz_int;
+    std::srand(2048);
+    for (size_t digits : {3, 20, 155, 617, 1233}) {
+        for (int rep = 0; rep < 3; rep++) {
+            std::string m = random_decimal(digits);
+            if (m[0] == '-') {
+                m.erase(0, 1);
+            }
+            m.back() = "1472"[rep % 4];
+            std::string b = random_decimal(digits + 5);
+            std::string e = random_decimal(digits);
+            if (e[0] == '-') {
+                e.erase(0, 1);
+            }
+            mpz_int gm{m}, gb{b}, ge{e};
+            mpz_int expected = boost::multiprecision::powm(gb, ge, gm);
+            if (expected < 0) {
+                expected += gm;
+            }
+            EXPECT_EQ(str(powmod(BigInt(b), BigInt(e), BigInt(m))), str(expected));
+        }
+    }
+    EXPECT_EQ(powmod(UBigInt(4), UBigInt(13), UBigInt(497)), UBigInt(445));
+    EXPECT_EQ(powmod(UBigInt(4), UBigInt(0), UBigInt(497)), UBigInt(1));
+    EXPECT_EQ(powmod(UBigInt(4), UBigInt(13), UBigInt(1)), UBigInt(0));
+    EXPECT_EQ(powmod(BigInt(-2), BigInt(3), BigInt(10)), BigInt(2));
+    EXPECT_THROW(powmod(UBigInt(4), UBigInt(2), UBigInt(0)), std::runtime_error);
+    EXPECT_THROW(powmod(BigInt(4), BigInt(-2), BigInt(7)), std::runtime_error);
+}
+
+
+/**
+ * @brief Unit test (gtest) for NTT multiplication, forced at small sizes and on all-ones limbs (largest convolution coefficients)
+ */
+TEST (arithmatic, ntt_multiplication_test) {
+    using boost::multiprecision::mpz_int;
+    std::srand(777);
+    for (size_t length : {20, 21, 300, 2000, 20000}) {
+        std::string s1 = random_decimal(length);
+        std::string s2 = random_decimal(length / 2 + 1);
+        BigInt a{s1}, b{s2};
+        a.set_ntt_thres(1);
+        EXPECT_EQ(str(a * b), str(mpz_int(mpz_int(s1) * mpz_int(s2))));
+        EXPECT_EQ(str(a * a), str(mpz_int(mpz_int(s1) * mpz_int(s1))));
+    }
+    for (unsigned limbs : {1u, 7u, 64u, 1000u}) {
+        mpz_int ones = (mpz_int(1) << (64 * limbs)) - 1;
+        BigInt a{str(ones)};
+        a.set_ntt_thres(1);
+        EXPECT_EQ(str(a * a), str(mpz_int(ones * ones)));
+    }
+}
+
+
+/**
+ * @brief Unit test (gtest) for Toom-Cook 3-way and 4-way multiplication forced at small sizes, balanced and unbalanced
+ */
+TEST (arithmatic, toom_multiplication_test) {
+    using boost::multiprecision::mpz_int;
+    std::srand(4242);
+    for (size_t length : {60, 61, 200, 1000, 5000}) {
+        for (size_t divisor : {1, 2, 5}) {
+            std::string s1 = random_decimal(length);
+            std::string s2 = random_decimal(length / divisor);
+            BigInt a{s1}, b{s2};
+            std::string expected = str(mpz_int(mpz_int(s1) * mpz_int(s2)));
+            a.set_toom3_thres(3).set_toom4_thres(1000000);
+            EXPECT_EQ(str(a * b), expected);
+            a.set_toom4_thres(4);
+            EXPECT_EQ(str(a * b), expected);
+            a.set_karatsuba_thres(8).set_toom3_thres(16).set_toom4_thres(40);
+            EXPECT_EQ(str(a * b), expected);
+        }
+    }
+}
+
+
+/**
+ * @brief Unit test (gtest) for squaring through every multiplication algorithm (operand aliasing selects the squaring paths)
+ */
+TEST (arithmatic, squaring_test) {
+    using boost::multiprecision::mpz_int;
+    std::srand(1717);
+    for (size_t length : {1, 19, 20, 100, 700, 3000, 9000}) {
+        std::string s1 = random_decimal(length);
+        std::string expected = str(mpz_int(mpz_int(s1) * mpz_int(s1)));
+        BigInt a{s1};
+        EXPECT_EQ(str(a * a), expected);
+        a.set_karatsuba_thres(2).set_toom3_thres(1000000).set_toom4_thres(1000000);
+        EXPECT_EQ(str(a * a), expected);
+        a.set_toom3_thres(6);
+        EXPECT_EQ(str(a * a), expected);
+        a.set_toom4_thres(12);
+        EXPECT_EQ(str(a * a), expected);
+        a.set_ntt_thres(30);
+        EXPECT_EQ(str(a * a), expected);
+        EXPECT_EQ(str(BigInt(a).square()), expected);
+        BigInt b = a;
+        b *= b;
+        EXPECT_EQ(str(b), expected);
+
+        UBigInt u{s1[0] == '-' ? s1.substr(1) : s1};
+        EXPECT_EQ(u * u, UBigInt(u).square());
+        u *= u;
+        EXPECT_EQ(str(u), expected);
+    }
+}
+
+
+/**
+ * @brief Unit test (gtest) for large divisions taking the Burnikel-Ziegler path, including exact and near-boundary quotients
+ */
+TEST (arithmatic, large_division_test) {
+    using boost::multiprecision::mpz_int;
+    std::srand(99);
+    for (size_t divisor_length : {800, 1500, 4000}) {
+        for (size_t dividend_length : {divisor_length + 800, divisor_length * 2, divisor_length * 3 + 7}) {
+            std::string s1 = random_decimal(dividend_length);
+            std::string s2 = random_decimal(divisor_length);
+            mpz_int ga{s1}, gb{s2};
+            EXPECT_EQ(str(BigInt(s1) / BigInt(s2)), str(mpz_int(ga / gb)));
+            mpz_int exact = gb * mpz_int(random_decimal(dividend_length - divisor_length));
+            EXPECT_EQ(str(BigInt(str(exact)) / BigInt(s2)), str(mpz_int(exact / gb)));
+            EXPECT_EQ(str(BigInt(str(mpz_int(exact - 1))) / BigInt(s2)), str(mpz_int((exact - 1) / gb)));
+        }
+    }
+    mpz_int ones = (mpz_int(1) << (64 * 300)) - 1;
+    mpz_int top = mpz_int(1) << (64 * 100 - 1);
+    EXPECT_EQ(str(BigInt(str(ones)) / BigInt(str(top))), str(mpz_int(ones / top)));
+    EXPECT_EQ(str(BigInt(str(ones)) / BigInt(str(mpz_int(top + 1)))), str(mpz_int(ones / (top + 1))));
+}
+
+
+TEST (arithmatic, schoolbook_division_test) {
+    using boost::multiprecision::mpz_int;
+    std::srand(7);
+    // limbs drawn from extreme patterns exercise the quotient estimate refinement and the add-back correction
+    const char *patterns[] = {"0", "1", "9223372036854775808", "18446744073709551615", "18446744073709551614"};
+    auto random_limbs = [&](size_t count) {
+        mpz_int value = 0;
+        for (size_t i = 0; i < count; i++) {
+            value = (value << 64) + mpz_int(patterns[std::rand() % 5]);
+        }
+        return value;
+    };
+    for (int rep = 0; rep < 300; rep++) {
+        size_t divisor_limbs = 2 + std::rand() % 6;
+        mpz_int gb = random_limbs(divisor_limbs) | (mpz_int(1) << (64 * divisor_limbs - 1 - std::rand() % 3));
+        mpz_int ga = random_limbs(divisor_limbs + std::rand() % 8);
+        BigInt ta{str(ga)}, tb{str(gb)};
+        EXPECT_EQ(str(ta / tb), str(mpz_int(ga / gb)));
+        EXPECT_EQ(str(ta % tb), str(mpz_int(ga % gb)));
+    }
+    for (size_t length : {40, 200, 700}) {
+        std::string s1 = random_decimal(length);
+        std::string s2 = random_decimal(length / 3 + 20);
+        EXPECT_EQ(str(BigInt(s1) / BigInt(s2)), str(mpz_int(mpz_int(s1) / mpz_int(s2))));
+    }
+}
+
+
+TEST (arithmatic, newton_division_test) {
+    std::srand(5);
+    // operands past the Newton reciprocal threshold, built by squaring since parsing that many digits is slow
+    UBigInt b{random_decimal(330)}, c{random_decimal(320)};
+    for (int i = 0; i < 10; i++) {
+        b *= b + 1;
+        c *= c + 3;
+    }
+    UBigInt d = b - UBigInt(random_decimal(50));
+    UBigInt a = b * c + d;
+    ASSERT_GT(b.get_limb_count(), 16000u);
+    ASSERT_GT(c.get_limb_count(), 16000u);
+    EXPECT_TRUE(a / b == c);
+    EXPECT_TRUE((a - d) / b == c);
+    EXPECT_TRUE((a - d - 1) / b == c - 1);
+    UBigInt e = a + c * c;
+    UBigInt q = e / c;
+    EXPECT_TRUE(e - q * c < c);
+}
+
+
+/**
+ * @brief Unit test (gtest) for lazily evaluated expressions against eager arithmatic, including products that cross zero and aliased destinations
+ */
+TEST (arithmatic, expression_template_test) {
+    std::srand(2024);
+    for (size_t length : {1, 20, 39, 200, 700, 2000}) {
+        for (int rep = 0; rep < 4; rep++) {
+            BigInt a{random_decimal(length)}, b{random_decimal(length / (rep + 1) + 1)};
+            BigInt c{random_decimal(length)}, d{random_decimal(length)}, e{random_decimal(2 * length)};
+            BigInt expected = a * b + c * d - e;
+            BigInt r = lazy(a) * b + lazy(c) * d - e;
+            EXPECT_EQ(r, expected);
+            EXPECT_EQ(assign(r, e - lazy(a) * b), e - a * b);
+            EXPECT_EQ(assign(r, lazy(a) * a - lazy(b) * b), a * a - b * b);
+            EXPECT_EQ(BigInt(lazy(a) * (lazy(c) + d) * b), a * (c + d) * b);
+            r = c;
+            r -= lazy(a) * b;
+            EXPECT_EQ(r, c - a * b);
+            r += lazy(r) * a + e;
+            EXPECT_EQ(r, (c - a * b) * (a + 1) + e);
+            EXPECT_EQ(assign(r, lazy(a) * r - 3), a * ((c - a * b) * (a + 1) + e) - 3);
+        }
+    }
+
+    UBigInt ua{"340282366920938463463374607431768211456"}, ub{"18446744073709551617"};
+    UBigInt uc = lazy(ua) - lazy(ub) * ub + ua;
+    EXPECT_EQ(uc, ua + ua - ub * ub);
+    EXPECT_THROW(UBigInt(lazy(ub) - ua), std::runtime_error);
+    uc += lazy(ub) * ub;
+    EXPECT_EQ(uc, ua + ua);
+
+    // a failed unsigned accumulation leaves the destination untouched
+    UBigInt small = 5, thousand = 1000;
+    EXPECT_THROW(small -= lazy(thousand) * lazy(thousand), std::runtime_error);
+    EXPECT_EQ(small, UBigInt(5));
+    EXPECT_THROW(uc -= lazy(ua) * ub + ua + ua, std::runtime_error);
+    EXPECT_EQ(uc, ua + ua);
+}
+
+
+/**
+ * @brief Unit test (gtest) for fused multiply-add/subtract (dot products and Horner-style accumulation)
+ */
+TEST (arithmatic, addmul_test) {
+    std::srand(4711);
+    for (size_t length : {1, 20, 100, 700, 3000}) {
+        std::vector<BigInt> x, y;
+        BigInt dot, expected;
+        for (int i = 0; i < 8; i++) {
+            x.emplace_back(random_decimal(length));
+            y.emplace_back(random_decimal(length / (i + 1) + 1));
+            addmul(dot, x[i], y[i]);
+            expected += x[i] * y[i];
+            EXPECT_EQ(dot, expected);
+            submul(dot, y[i], x[0]);
+            expected -= y[i] * x[0];
+            EXPECT_EQ(dot, expected);
+        }
+        addmul(dot, dot, x[1]);
+        EXPECT_EQ(dot, expected + expected * x[1]);
+        expected = dot;
+        addmul_ui(dot, x[2], 18446744073709551615ull);
+        submul_ui(dot, x[3], 7);
+        EXPECT_EQ(dot, expected + x[2] * BigInt(18446744073709551615ull) - x[3] * 7);
+        submul(dot, dot, 1);
+        EXPECT_EQ(dot, 0);
+    }
+
+    UBigInt ua{"340282366920938463463374607431768211457"}, ub{"18446744073709551616"};
+    UBigInt uc = ua;
+    submul(uc, ub, ub);
+    EXPECT_EQ(uc, UBigInt(1));
+    addmul_ui(uc, ub, 3);
+    EXPECT_EQ(uc, ub * 3 + 1);
+    EXPECT_THROW(submul(uc, ub, ub), std::runtime_error);
+    EXPECT_EQ(uc, ub * 3 + 1);
+    EXPECT_THROW(submul_ui(uc, ub, 4), std::runtime_error);
+    EXPECT_EQ(uc, ub * 3 + 1);
+}
+
+
+/**
+ * @brief Unit test (gtest) for the rvalue operator overloads against their const reference counterparts
+ */
+TEST (arithmatic, rvalue_operator_test) {
+    std::srand(99);
+    for (size_t length : {1, 20, 100, 700}) {
+        for (int rep = 0; rep < 4; rep++) {
+            BigInt a{random_decimal(length)}, b{random_decimal(length / (rep + 1) + 1)};
+            BigInt sum = a + b, diff = a - b, prod = a * b, quo = a / b, rem = a % b;
+            EXPECT_EQ(BigInt(a) + b, sum);
+            EXPECT_EQ(a + BigInt(b), sum);
+            EXPECT_EQ(BigInt(a) + BigInt(b), sum);
+            EXPECT_EQ(BigInt(a) - b, diff);
+            EXPECT_EQ(a - BigInt(b), diff);
+            EXPECT_EQ(BigInt(a) - BigInt(b), diff);
+            EXPECT_EQ(b - BigInt(a), BigInt(0) - diff);
+            EXPECT_EQ(BigInt(a) * b, prod);
+            EXPECT_EQ(a * BigInt(b), prod);
+            EXPECT_EQ(BigInt(a) * BigInt(b), prod);
+            EXPECT_EQ(BigInt(a) / b, quo);
+            EXPECT_EQ(a / BigInt(b), quo);
+            EXPECT_EQ(BigInt(a) / BigInt(b), quo);
+            EXPECT_EQ(BigInt(a) % b, rem);
+            EXPECT_EQ(a % BigInt(b), rem);
+            EXPECT_EQ(BigInt(a) % BigInt(b), rem);
+            EXPECT_EQ(a * b + b * a - a * b * 2, 0);
+            EXPECT_EQ(a - BigInt(a), 0);
+        }
+    }
+
+    UBigInt ua{"340282366920938463463374607431768211456"}, ub{"18446744073709551617"};
+    EXPECT_EQ(ua - UBigInt(ub), UBigInt("340282366920938463444927863358058659839"));
+    EXPECT_EQ(ua / UBigInt(ub), UBigInt("18446744073709551615"));
+    EXPECT_EQ(ua % UBigInt(ub), UBigInt(1));
+    EXPECT_EQ(UBigInt(ua) * UBigInt(ub) - ua * ub, 0);
+    EXPECT_THROW(ub - UBigInt(ua), std::runtime_error);
+}
+
+
+/**
+ * @brief Unit test (gtest) for multiplication with sub-products running on a thread pool; results must match the serial algorithms
+ */
+TEST (arithmatic, parallel_multiplication_test) {
+    using boost::multiprecision::mpz_int;
+    std::srand(2024);
+    ThreadPool pool{4};
+    for (size_t length : {50, 700, 3000, 9000}) {
+        std::string s1 = random_decimal(length);
+        std::string s2 = random_decimal(length / 3 + 1);
+        std::string product = str(mpz_int(mpz_int(s1) * mpz_int(s2)));
+        std::string square = str(mpz_int(mpz_int(s1) * mpz_int(s1)));
+        BigInt a{s1}, b{s2};
+        a.set_parallel_thres(4).set_karatsuba_thres(4).set_toom3_thres(1000000).set_toom4_thres(1000000);
+        ParallelScope scope{&pool, 3};
+        EXPECT_EQ(str(a * b), product);
+        EXPECT_EQ(str(a * a), square);
+        a.set_toom3_thres(12);
+        EXPECT_EQ(str(a * b), product);
+        EXPECT_EQ(str(a * a), square);
+        a.set_toom4_thres(40);
+        EXPECT_EQ(str(a * b), product);
+        EXPECT_EQ(str(a * a), square);
+        a.set_ntt_thres(30);
+        EXPECT_EQ(str(a * b), product);
+        EXPECT_EQ(str(a * a), square);
+    }
+
+    // default thresholds; a disabled scope and a depth of zero take the serial paths
+    UBigInt ua = UBigInt().randomize(20000), ub = UBigInt().randomize(15000);
+    UBigInt expected = ua * ub;
+    {
+        ParallelScope scope{&pool};
+        EXPECT_EQ(ua * ub, expected);
+        EXPECT_EQ(UBigInt(ua).square(), ua * ua);
+        ParallelScope serial{&pool, 0};
+        EXPECT_EQ(ParallelScope::pool(), nullptr);
+        EXPECT_EQ(ua * ub, expected);
+    }
+    EXPECT_EQ(ParallelScope::pool(), nullptr);
+}
+
+
+/**
+ * @brief Unit test (gtest) for balanced tree sum and product of ranges, serial and on a thread pool, against left folds
+ */
+TEST (arithmatic, range_reduction_test) {
+    std::srand(314);
+    std::vector<BigInt> values;
+    for (int i = 0; i < 3000; i++) {
+        values.emplace_back((i % 7 == 3 ? "-" : "") + random_decimal(1 + std::rand() % 40));
+    }
+    BigInt sum = 0, product = 1;
+    for (const BigInt &value : values) {
+        sum += value;
+        product *= value;
+    }
+    EXPECT_EQ(BigInt::sum(values.begin(), values.end()), sum);
+    EXPECT_EQ(BigInt::product(values.begin(), values.end()), product);
+
+    ThreadPool pool{3};
+    EXPECT_EQ(BigInt::sum(pool, values.begin(), values.end()), sum);
+    EXPECT_EQ(BigInt::product(pool, values.begin(), values.end()), product);
+    EXPECT_EQ(BigInt::product(pool, values.begin(), values.begin() + 3), values[0] * values[1] * values[2]);
+
+    std::list<int> small{-4, 5, 6};
+    EXPECT_EQ(BigInt::sum(small.begin(), small.end()), 7);
+    EXPECT_EQ(BigInt::product(small.begin(), small.end()), -120);
+    EXPECT_EQ(BigInt::sum(small.end(), small.end()), 0);
+    EXPECT_EQ(BigInt::product(small.end(), small.end()), 1);
+    EXPECT_EQ(BigInt::product(small.begin(), std::next(small.begin())), -4);
+}
+
+
+/**
+ * @brief Unit test (gtest) for factorial, binomial and primorial against GMP and direct products
+ */
+TEST (arithmatic, combinatorics_test) {
+    using boost::multiprecision::mpz_int;
+    EXPECT_EQ(Combinatorics::primes(1).size(), 0u);
+    EXPECT_EQ(Combinatorics::primes(2), std::vector<std::uint64_t>{2});
+    EXPECT_EQ(Combinatorics::primes(30), (std::vector<std::uint64_t>{2, 3, 5, 7, 11, 13, 17, 19, 23, 29}));
+    EXPECT_EQ(Combinatorics::primes(1000000).size(), 78498u);
+
+    EXPECT_EQ(factorial(0), 1);
+    EXPECT_EQ(factorial(1), 1);
+    EXPECT_EQ(factorial(20), BigInt(2432902008176640000ull));
+    for (std::uint64_t n : {25, 100, 1000, 5000, 30000}) {
+        mpz_int expected = 1;
+        for (std::uint64_t i = 2; i <= n; i++) {
+            expected *= i;
+        }
+        EXPECT_EQ(str(factorial(n)), str(expected));
+        mpz_int choose = 1;
+        for (std::uint64_t i = 1; i <= n / 3; i++) {
+            choose = choose * (n - n / 3 + i) / i;
+        }
+        EXPECT_EQ(str(binomial(n, n / 3)), str(choose));
+    }
+    EXPECT_EQ(binomial(10, 0), 1);
+    EXPECT_EQ(binomial(10, 10), 1);
+    EXPECT_EQ(binomial(10, 3), 120);
+    EXPECT_EQ(binomial(52, 5), 2598960);
+    EXPECT_EQ(binomial(3, 4), 0);
+    EXPECT_EQ(binomial(1000, 1), 1000);
+    // small k takes the falling factorial path, which never sieves up to n
+    EXPECT_EQ(str(binomial(1000000000000ull, 3)), str(mpz_int(1000000000000ull) * 999999999999ull * 999999999998ull / 6));
+    EXPECT_EQ(binomial(~0ull, 1), BigInt(~0ull));
+    EXPECT_EQ(binomial(~0ull, ~0ull - 2), BigInt(~0ull) * BigInt(~0ull - 1) / 2);
+    for (std::uint64_t n : {640, 641, 5000, 30000}) {
+        for (std::uint64_t k : {n / 64 - 1, n / 64, n - n / 64 + 1}) {
+            mpz_int choose = 1;
+            for (std::uint64_t i = 1; i <= std::min(k, n - k); i++) {
+                choose = choose * (n - std::min(k, n - k) + i) / i;
+            }
+            EXPECT_EQ(str(binomial(n, k)), str(choose));
+        }
+    }
+
+    EXPECT_EQ(primorial(0), 1);
+    EXPECT_EQ(primorial(2), 2);
+    EXPECT_EQ(primorial(30), 6469693230ull);
+    std::vector<std::uint64_t> primes = Combinatorics::primes(20000);
+    EXPECT_EQ(primorial(20000), BigInt::product(primes.begin(), primes.end()));
+}
+
+
+/**
+ * @brief Unit test (gtest) for bitwise operators, shifts and bit access; negative values behave as infinite two's complement (checked against GMP)
+ */
+TEST (arithmatic, bitwise_test) {
+    using boost::multiprecision::mpz_int;
+    std::srand(2024);
+    std::vector<std::string> operands = {"0", "1", "-1", "-2", "18446744073709551615", "-18446744073709551615", "18446744073709551616",
+                                         "-18446744073709551616", "-340282366920938463463374607431768211456"};
+    for (size_t length : {5, 19, 20, 60, 400}) {
+        operands.push_back(random_decimal(length));
+        operands.push_back(random_decimal(length));
+    }
+    for (const std::string &s1 : operands) {
+        BigInt a{s1};
+        mpz_int ga{s1};
+        EXPECT_EQ(str(~a), str(mpz_int(~ga)));
+        for (size_t m : {0, 1, 63, 64, 65, 200}) {
+            EXPECT_EQ(str(a << m), str(mpz_int(ga << m)));
+            EXPECT_EQ(str(a >> m), str(mpz_int(ga >> m))) << s1 << " >> " << m;
+        }
+        for (size_t i : {0, 1, 63, 64, 127, 128, 1000, 1400}) {
+            EXPECT_EQ(a.test_bit(i), bit_test(ga, i)) << s1 << " bit " << i;
+            BigInt set = a, cleared = a;
+            mpz_int gset = ga, gcleared = ga;
+            EXPECT_EQ(str(set.set_bit(i)), str(bit_set(gset, i)));
+            EXPECT_EQ(str(cleared.set_bit(i, false)), str(bit_unset(gcleared, i)));
+        }
+        for (const std::string &s2 : operands) {
+            BigInt b{s2};
+            mpz_int gb{s2};
+            EXPECT_EQ(str(a & b), str(mpz_int(ga & gb))) << s1 << " & " << s2;
+            EXPECT_EQ(str(a | b), str(mpz_int(ga | gb))) << s1 << " | " << s2;
+            EXPECT_EQ(str(a ^ b), str(mpz_int(ga ^ gb))) << s1 << " ^ " << s2;
+        }
+    }
+
+    BigInt c{"-12345678901234567890123"};
+    c ^= c;
+    EXPECT_EQ(c, BigInt(0));
+    c = BigInt(-5);
+    c &= BigInt(-3);
+    EXPECT_EQ(c, BigInt(-7));
+    c >>= 1;
+    EXPECT_EQ(c, BigInt(-4));
+    c <<= 70;
+    EXPECT_EQ(str(c), "-4722366482869645213696");
+
+    UBigInt u{"340282366920938463463374607431768211455"};
+    EXPECT_EQ(u >> 64, UBigInt("18446744073709551615"));
+    EXPECT_EQ((u << 3) >> 3, u);
+    EXPECT_EQ(u & UBigInt(255), UBigInt(255));
+    EXPECT_EQ(u ^ u, UBigInt(0));
+    EXPECT_EQ(UBigInt(12) | UBigInt("18446744073709551616"), UBigInt("18446744073709551628"));
+    EXPECT_TRUE(u.test_bit(127));
+    EXPECT_FALSE(u.test_bit(128));
+    EXPECT_EQ(u.set_bit(127, false).set_bit(126, false), UBigInt("85070591730234615865843651857942052863"));
+    EXPECT_EQ(UBigInt().set_bit(64), UBigInt("18446744073709551616"));
+
+    // a sign passed with a zero magnitude is dropped, so bit access and ~ see an ordinary zero
+    std::vector<int> zeros = {0, 0, 0};
+    for (const BigInt &zero : {BigInt(UBigInt(0), true), BigInt('0', true), BigInt(zeros.begin(), zeros.end(), true)}) {
+        EXPECT_EQ(zero, BigInt(0));
+        EXPECT_EQ(std::hash<BigInt>{}(zero), std::hash<BigInt>{}(BigInt(0)));
+        EXPECT_FALSE(zero.test_bit(0));
+        EXPECT_FALSE(zero.test_bit(500));
+        EXPECT_EQ(~zero, BigInt(-1));
+        BigInt set = zero;
+        EXPECT_EQ(set.set_bit(3), BigInt(8));
+    }
+
+    // compound assignments work in place, also on themselves, and keep the multiplication thresholds
+    BigInt p{"-340282366920938463463374607431768211456"};
+    BigInt q{"18446744073709551617"};
+    for (const BigInt &rhs : {q, BigInt(0) - q, p, BigInt(-1), BigInt(0)}) {
+        BigInt a = p;
+        a.set_karatsuba_thres(7);
+        EXPECT_EQ(a &= rhs, p & rhs);
+        EXPECT_EQ(a.get_karatsuba_thres(), 7u);
+        a = p;
+        a.set_karatsuba_thres(7);
+        EXPECT_EQ(a |= rhs, p | rhs);
+        EXPECT_EQ(a.get_karatsuba_thres(), 7u);
+        a = p;
+        a.set_karatsuba_thres(7);
+        EXPECT_EQ(a ^= rhs, p ^ rhs);
+        EXPECT_EQ(a.get_karatsuba_thres(), 7u);
+    }
+    BigInt self = p;
+    EXPECT_EQ(self &= self, p);
+    EXPECT_EQ(self |= self, p);
+    EXPECT_EQ(self ^= self, BigInt(0));
+}
@@ -6,13 +6,13 @@
 
 /**
  * @brief Unit test (gtest) for division arithmatic. Always returns "PASS" but informs user if they should change the threshold from default.
- * The karatsuba threshold is the minimum length (in digits) that use karatsuba recursive multiplication algorithm vs long multiplication (base-case) for recursion.
+ * The karatsuba threshold is the minimum length (in limbs) that use karatsuba recursive multiplication algorithm vs long multiplication (base-case) for recursion.
  */
 TEST (karatsuba, karatsuba_calibration) {
-	std::pair<int, int> k_test_limits= {16,128};
-    int k_test_increment = 16;
+	std::pair<int, int> k_test_limits= {8,64};
+    int k_test_increment = 8;
     int n_per_increment = 5;
-    size_t size_number=1000 ;
+    size_t size_number=20000 ;
     BigInt a = BigInt().randomize(size_number);
     BigInt b = BigInt().randomize(size_number);
     std::vector<std::pair<int, double>> kthres_vs_time;
@@ -37,7 +37,7 @@ TEST (karatsuba, karatsuba_calibration) {
     auto optim_digits = std::min_element(kthres_vs_time.begin(), kthres_vs_time.end(),
                                   [](const auto &lhs, const auto &rhs) {return lhs.second < rhs.second;});
 
-    std::cout << "Optimal karatsuba digits threshold = " << optim_digits->first << std::endl;
+    std::cout << "Optimal karatsuba limbs threshold = " << optim_digits->first << std::endl;
     if (optim_digits->first != BigInt().get_karatsuba_thres()) {
         std::cout << "Warning: optimal karatsuba multiplication threshold different than current default threshold. It is recommended to change to optimal threshold." << std::endl;
     }
@@ -46,3 +46,46 @@ TEST (karatsuba, karatsuba_calibration) {
     }
 	EXPECT_EQ(1,1);
 }
+
+
+/**
+ * @brief Calibration (gtest) of the Toom-Cook 3-way threshold. Always returns "PASS" but informs user if they should change the threshold from default.
+ * The toom3 threshold is the minimum length (in limbs) that use Toom-Cook 3-way multiplication vs karatsuba.
+ */
+TEST (karatsuba, toom3_calibration) {
+    std::pair<int, int> t_test_limits= {150,400};
+    int t_test_increment = 50;
+    int n_per_increment = 3;
+    size_t size_number=40000 ;
+    BigInt a = BigInt().randomize(size_number);
+    BigInt b = BigInt().randomize(size_number);
+    std::vector<std::pair<int, double>> tthres_vs_time;
+    std::cout << "Running Toom-3 Multiplication size threshold calibration..." << std::endl;
+    std::cout << "Current Toom-3 Multiplication default threshold : " << BigInt().get_toom3_thres() << std::endl;
+    for (int tthres = t_test_limits.first; tthres <= t_test_limits.second; tthres += t_test_increment) {
+        std::cout << "Testing threshold = " << tthres << std::endl;
+        a.set_toom3_thres(tthres).set_toom4_thres(100000).set_ntt_thres(100000);
+        std::vector<double> itimes;
+        for (int i = 0; i < n_per_increment; i++){
+            std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+            auto sol = a*b;
+            std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+            std::chrono::duration<double> time_span = std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1);
+            itimes.push_back(time_span.count());
+        }
+        double sum = std::accumulate(std::begin(itimes), std::end(itimes), 0.0);
+        double mean =  sum / itimes.size();
+        tthres_vs_time.push_back({tthres, mean});
+    }
+    auto optim_limbs = std::min_element(tthres_vs_time.begin(), tthres_vs_time.end(),
+                                  [](const auto &lhs, const auto &rhs) {return lhs.second < rhs.second;});
+
+    std::cout << "Optimal toom3 limbs threshold = " << optim_limbs->first << std::endl;
+    if (optim_limbs->first != static_cast<int>(BigInt().get_toom3_thres())) {
+        std::cout << "Warning: optimal toom3 multiplication threshold different than current default threshold. It is recommended to change to optimal threshold." << std::endl;
+    }
+    else {
+        std::cout << "Default toom3 multiplication threshold is optimal" << std::endl;
+    }
+    EXPECT_EQ(1,1);
+}
@@ -1,5 +1,38 @@
 #include <gtest/gtest.h>
 #include "bigint.h"
+#include "expression.h"
+#include "thread_pool.h"
+#include <sstream>
+#include <vector>
+#include <cstdlib>
+#include <array>
+#include <memory_resource>
+#include <atomic>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+
+/**
+ * @brief Memory resource counting the allocations it serves
+ */
+class CountingResource : public std::pmr::memory_resource {
+public:
+    size_t count = 0;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        count++;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+};
+
 
 TEST (utility, utility_tests){
     BigInt ta{"123456789"};
@@ -9,8 +42,20 @@ TEST (utility, utility_tests){
     EXPECT_EQ(ta.shift10(-4), BigInt(12345678));
 
     BigInt tb{"1234567"};
-    EXPECT_EQ(tb.get_length(), 7);
-    EXPECT_EQ((tb-tb).get_length(), 1);
+    EXPECT_EQ(tb.get_length(), 7u);
+    EXPECT_EQ((tb-tb).get_length(), 1u);
+    for (std::uint64_t k = 1; k < 400; k += 7) {
+        UBigInt power = pow(UBigInt(10), k);
+        for (const UBigInt &x : {power - 1, power, power + 1}) {
+            EXPECT_EQ(x.get_length(), x.to_string().size()) << k;
+        }
+    }
+    std::srand(5);
+    for (size_t limbs = 2; limbs < 300; limbs += 13) {
+        UBigInt x = UBigInt().randomize(limbs * 19);
+        EXPECT_EQ(x.get_length(), x.to_string().size());
+        EXPECT_EQ(BigInt(x, true).get_length(), x.to_string().size());
+    }
 
     BigInt tc{"452349"};
     EXPECT_EQ(tc++, BigInt("452349"));
@@ -19,3 +64,405 @@ TEST (utility, utility_tests){
     BigInt td{"452349"};
     EXPECT_EQ((++td), BigInt("452350"));
 }
+
+
+TEST (utility, comparison_tests){
+    std::vector<BigInt> sorted = {BigInt("-340282366920938463463374607431768211457"), BigInt("-18446744073709551616"), BigInt(-5), BigInt(0),
+                                  BigInt(3), BigInt("18446744073709551615"), BigInt("18446744073709551616"), BigInt("340282366920938463463374607431768211456")};
+    for (size_t i = 0; i < sorted.size(); i++) {
+        for (size_t j = 0; j < sorted.size(); j++) {
+            int expected = i < j ? -1 : (i > j ? 1 : 0);
+            int cmp = compare(sorted[i], sorted[j]);
+            EXPECT_EQ((cmp > 0) - (cmp < 0), expected) << i << " " << j;
+            EXPECT_EQ(sorted[i] < sorted[j], i < j);
+            EXPECT_EQ(sorted[i] <= sorted[j], i <= j);
+            EXPECT_EQ(sorted[i] > sorted[j], i > j);
+            EXPECT_EQ(sorted[i] >= sorted[j], i >= j);
+        }
+    }
+    EXPECT_LT(compare(UBigInt("18446744073709551617"), UBigInt("36893488147419103232")), 0);
+    EXPECT_EQ(compare(UBigInt(), UBigInt(0)), 0);
+
+    // equal values built differently compare and hash equally, including a zero produced by subtraction
+    BigInt x = BigInt("123456789012345678901234567890") * BigInt(-7);
+    BigInt y = BigInt("-864197523086419752308641975230");
+    EXPECT_EQ(compare(x, y), 0);
+    EXPECT_EQ(std::hash<BigInt>{}(x), std::hash<BigInt>{}(y));
+    EXPECT_EQ(std::hash<BigInt>{}(x - y), std::hash<BigInt>{}(BigInt(0)));
+    EXPECT_NE(std::hash<BigInt>{}(x), std::hash<BigInt>{}(BigInt(0) - x));
+    EXPECT_EQ(std::hash<UBigInt>{}(UBigInt("99999999999999999999")), std::hash<UBigInt>{}(UBigInt("100000000000000000000") - 1));
+
+    std::map<BigInt, int> ordered;
+    std::unordered_map<BigInt, int> unordered;
+    std::unordered_set<UBigInt> magnitudes;
+    for (size_t i = 0; i < sorted.size(); i++) {
+        ordered[sorted[sorted.size() - 1 - i]] = static_cast<int>(i);
+        unordered[sorted[i]] = static_cast<int>(i);
+        std::ostringstream out;
+        out << sorted[i];
+        magnitudes.insert(UBigInt(out.str().substr(sorted[i] < 0)));
+    }
+    EXPECT_TRUE(std::equal(ordered.begin(), ordered.end(), sorted.begin(), [](const auto &entry, const BigInt &v) {return entry.first == v;}));
+    for (size_t i = 0; i < sorted.size(); i++) {
+        EXPECT_EQ(unordered.at(sorted[i]), static_cast<int>(i));
+    }
+    EXPECT_EQ(magnitudes.size(), sorted.size() - 1);  // 2^64 occurs with both signs
+
+    // a failed unsigned subtraction leaves the operand untouched
+    UBigInt small{"18446744073709551616"};
+    EXPECT_THROW(small -= UBigInt("18446744073709551617"), std::runtime_error);
+    EXPECT_EQ(small, UBigInt("18446744073709551616"));
+    EXPECT_THROW(UBigInt(5) - UBigInt("18446744073709551617"), std::runtime_error);
+    EXPECT_THROW(UBigInt(5) - UBigInt(6), std::runtime_error);
+}
+
+TEST (utility, limb_representation_tests){
+    UBigInt ua{"18446744073709551615"};
+    EXPECT_EQ(ua.get_limb_count(), 1u);
+    EXPECT_EQ(++ua, UBigInt("18446744073709551616"));
+    EXPECT_EQ(ua.get_limb_count(), 2u);
+    EXPECT_EQ(--ua, UBigInt(18446744073709551615ull));
+    EXPECT_EQ(UBigInt(0).get_limb_count(), 0u);
+    EXPECT_EQ(UBigInt(0).to_string(), "0");
+
+    std::vector<int> digits{0, 0, 4, 2, 0, 7};
+    EXPECT_EQ(UBigInt(digits.begin(), digits.end()), UBigInt(4207));
+    EXPECT_EQ(BigInt(-9223372036854775807ll - 1), BigInt("-9223372036854775808"));
+
+    std::string s = "1234567890123456789012345678901234567890";
+    UBigInt ub{s};
+    EXPECT_EQ(ub.to_string(), s);
+    EXPECT_EQ(ub.get_length(), s.size());
+    EXPECT_EQ(ub.get_slice(3, 25), UBigInt(s.substr(3, 22)));
+    EXPECT_EQ(UBigInt(ub).shift10(40).shift10(-40), ub);
+    EXPECT_EQ(UBigInt(ub).shift10(-39), UBigInt(1));
+    EXPECT_EQ(UBigInt(ub).shift10(-41), UBigInt(0));
+
+    std::stringstream ss;
+    ss << BigInt("-" + s);
+    EXPECT_EQ(ss.str(), "-" + s);
+}
+
+
+TEST (utility, small_value_allocation_tests){
+    UBigInt ua{"340282366920938463463374607431768211455"};
+    UBigInt ub{12345678901234567ull};
+    BigInt ta{-42};
+    BigInt tb{"99999999999999999999999"};
+    CountingResource counting;
+    {
+        MemoryScope scope{&counting};
+        for (int i = 0; i < 100; i++) {
+            ++ub;
+            ub -= 1;
+            UBigInt uc = (ua + ub) * ub / ub;
+            ta *= tb;
+            ta /= tb;
+            ta += tb - ta;
+            EXPECT_TRUE(uc > ua);
+            EXPECT_EQ(ta, tb);
+            ta = -42;
+        }
+        EXPECT_EQ(counting.count, 0u);
+
+        UBigInt big = ua * ua;
+        big *= big;
+        EXPECT_GT(counting.count, 0u);
+    }
+}
+
+
+TEST (utility, memory_resource_tests){
+    BigInt a{std::string(400, '7')};
+    BigInt b{"-" + std::string(300, '3')};
+    BigInt expected = a * b * b / a;
+
+    std::array<std::byte, 1 << 16> buffer;
+    MemoryArena arena{buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+    CountingResource counting;
+    std::pmr::memory_resource *previous_default = std::pmr::set_default_resource(&counting);
+    {
+        MemoryScope scope{&arena};
+        BigInt ta = a;
+        BigInt tb = b;
+        EXPECT_EQ(ta.get_resource(), &arena);
+        ta *= tb;
+        ta *= tb;
+        ta /= a;
+        EXPECT_TRUE(ta == expected);
+    }
+    std::pmr::set_default_resource(previous_default);
+    EXPECT_EQ(counting.count, 0u);
+
+    UBigInt ua{&arena};
+    EXPECT_EQ(ua.get_resource(), &arena);
+    EXPECT_EQ(UBigInt().get_resource(), std::pmr::get_default_resource());
+    UBigInt ub = UBigInt(std::string(400, '7')) * UBigInt(std::string(400, '7'));
+    EXPECT_EQ(ub.get_resource(), std::pmr::get_default_resource());
+}
+
+
+TEST (utility, decimal_conversion_tests){
+    std::srand(19);
+    for (size_t length : {379, 380, 381, 760, 761, 1520, 3041, 12160, 30001}) {
+        std::string s(length, '0');
+        s[0] = '1' + std::rand() % 9;
+        for (size_t i = 1; i < length; i++) {
+            s[i] = '0' + std::rand() % 10;
+        }
+        EXPECT_EQ(UBigInt(s).to_string(), s);
+        EXPECT_EQ(BigInt("-" + s), BigInt(0) - BigInt(s));
+
+        // runs of zeros straddling the recursive split points
+        std::string sparse = "1" + std::string(length - 2, '0') + "7";
+        EXPECT_EQ(UBigInt(sparse).to_string(), sparse);
+        UBigInt power = pow(UBigInt(10), static_cast<std::uint64_t>(length));
+        EXPECT_EQ(power, UBigInt("1" + std::string(length, '0')));
+        EXPECT_EQ((power - 1).to_string(), std::string(length, '9'));
+        EXPECT_EQ(power.get_length(), length + 1);
+    }
+}
+
+
+TEST (utility, chars_conversion_tests){
+    const std::string s = "-98765432109876543210987654321";
+    BigInt ta;
+    auto parsed = from_chars(s.data(), s.data() + s.size(), ta);
+    EXPECT_EQ(parsed.ec, std::errc{});
+    EXPECT_EQ(parsed.ptr, s.data() + s.size());
+    EXPECT_EQ(ta, BigInt(s));
+
+    char buffer[64];
+    auto written = to_chars(buffer, buffer + sizeof(buffer), ta);
+    EXPECT_EQ(written.ec, std::errc{});
+    EXPECT_EQ(std::string(buffer, written.ptr), s);
+    EXPECT_EQ(to_chars(buffer, buffer + 10, ta).ec, std::errc::value_too_large);
+    written = to_chars(buffer, buffer + 1, UBigInt(0));
+    EXPECT_EQ(std::string(buffer, written.ptr), "0");
+
+    // digits are scanned eight at a time; a non-digit inside a block must still stop the parse
+    const char mixed[] = "1234567890123:45";
+    UBigInt ua{7};
+    parsed = from_chars(mixed, mixed + sizeof(mixed) - 1, ua);
+    EXPECT_EQ(parsed.ptr, mixed + 13);
+    EXPECT_EQ(ua, UBigInt(1234567890123ull));
+    parsed = from_chars(mixed + 13, mixed + sizeof(mixed) - 1, ua);
+    EXPECT_EQ(parsed.ec, std::errc::invalid_argument);
+    EXPECT_EQ(ua, UBigInt(1234567890123ull));
+    EXPECT_EQ(from_chars(s.data(), s.data() + 1, ta).ec, std::errc::invalid_argument);
+    EXPECT_THROW(UBigInt("12a4"), std::runtime_error);
+    EXPECT_THROW(UBigInt("1234567890/"), std::runtime_error);
+
+    std::stringstream ss{"  42 -17 18446744073709551616 x"};
+    BigInt tb, tc;
+    UBigInt ub;
+    ss >> tb >> tc >> ub;
+    EXPECT_EQ(tb, BigInt(42));
+    EXPECT_EQ(tc, BigInt(-17));
+    EXPECT_EQ(ub, UBigInt("18446744073709551616"));
+    EXPECT_FALSE(ss.fail());
+    ss >> ub;
+    EXPECT_TRUE(ss.fail());
+
+    std::stringstream out;
+    out << ub << ' ' << tc;
+    EXPECT_EQ(out.str(), "18446744073709551616 -17");
+}
+
+
+TEST (utility, expression_allocation_tests){
+    BigInt a{std::string(190, '3')}, b{"-" + std::string(180, '7')};
+    BigInt c{std::string(170, '5')}, d{std::string(185, '9')}, e{std::string(100, '1')};
+    BigInt expected = a * b + c * d - e;
+    BigInt r;
+    assign(r, lazy(a) * b + lazy(c) * d - e);
+    CountingResource counting;
+    {
+        MemoryScope scope{&counting};
+        for (int i = 0; i < 10; i++) {
+            assign(r, lazy(a) * b + lazy(c) * d - e);
+            r -= lazy(c) * d;
+            r += lazy(c) * d;
+        }
+    }
+    EXPECT_EQ(counting.count, 0u);
+    EXPECT_EQ(r, expected);
+}
+
+
+TEST (utility, rvalue_operator_allocation_tests){
+    BigInt a{std::string(300, '8')}, b{"-" + std::string(250, '6')};
+    BigInt expected = (a + b) * b - a;
+    CountingResource counting;
+    MemoryScope scope{&counting};
+    BigInt sum = BigInt(a) + b;
+    EXPECT_EQ(counting.count, 1u);
+    sum = std::move(sum) - a;
+    sum = a + std::move(sum);
+    sum = b - std::move(sum);
+    sum = b - std::move(sum);
+    EXPECT_EQ(counting.count, 1u);
+    EXPECT_EQ(std::move(sum) * b - a, expected);
+}
+
+
+TEST (utility, view_tests){
+    UBigInt ua{"340282366920938463463374607431768211456"};
+    UBigIntView view = ua.view();
+    EXPECT_EQ(view.size(), 3u);
+    EXPECT_EQ(view.slice(0, 2).size(), 0u);
+    EXPECT_EQ(UBigInt(view.slice(2, 3)), UBigInt(1));
+    EXPECT_EQ(UBigInt(view.slice(1, 10)), UBigInt("18446744073709551616"));
+    EXPECT_EQ(UBigInt(view), ua);
+    EXPECT_TRUE(UBigIntView().empty());
+
+    // Karatsuba recurses on views into one preallocated scratch buffer: a constant number of allocations at any depth
+    UBigInt a = UBigInt().randomize(4000), b = UBigInt().randomize(3000);
+    UBigInt expected = a * b;
+    CountingResource counting;
+    {
+        MemoryScope scope{&counting};
+        UBigInt product = a * b;
+        EXPECT_LE(counting.count, 3u);
+        EXPECT_EQ(product, expected);
+    }
+}
+
+
+TEST (utility, thread_pool_tests){
+    ThreadPool pool{3};
+    EXPECT_EQ(pool.size(), 3u);
+    std::atomic<size_t> sum{0};
+    TaskGroup group;
+    for (size_t i = 1; i <= 1000; i++) {
+        pool.run(group, [&sum, i] {sum += i;});
+    }
+    pool.wait(group);
+    EXPECT_EQ(sum.load(), 500500u);
+
+    // nested groups: tasks spawn and wait on tasks of their own
+    ParallelScope scope{&pool, 2};
+    std::atomic<size_t> leaves{0};
+    parallel_for(8, [&leaves](size_t) {
+        EXPECT_EQ(ParallelScope::depth(), 1u);
+        parallel_for(8, [&leaves](size_t) {
+            EXPECT_EQ(ParallelScope::pool(), nullptr);
+            parallel_for(2, [&leaves](size_t) {leaves++;});
+        });
+    });
+    EXPECT_EQ(leaves.load(), 128u);
+    EXPECT_EQ(ParallelScope::depth(), 2u);
+
+    TaskGroup failing;
+    pool.run(failing, [] {throw std::runtime_error("task failure");});
+    pool.run(failing, [&sum] {sum = 0;});
+    EXPECT_THROW(pool.wait(failing), std::runtime_error);
+    EXPECT_EQ(sum.load(), 0u);
+    EXPECT_THROW(parallel_for(4, [](size_t i) {if (i == 3) throw std::logic_error("index");}), std::logic_error);
+
+    // f(0) runs on the calling thread; its exception is rethrown only after the other calls finished
+    std::thread::id caller = std::this_thread::get_id();
+    std::atomic<size_t> finished{0};
+    EXPECT_THROW(parallel_for(6, [&finished, caller](size_t i) {
+        if (i == 0) {
+            EXPECT_EQ(std::this_thread::get_id(), caller);
+            throw std::logic_error("first");
+        }
+        finished++;
+    }), std::logic_error);
+    EXPECT_EQ(finished.load(), 5u);
+
+    ThreadPool inline_pool{0};
+    ParallelScope inline_scope{&inline_pool};
+    UBigInt a = UBigInt().randomize(3000);
+    UBigInt b = a;
+    EXPECT_EQ(a * a, b * b);
+}
+
+
+TEST (utility, simd_kernel_tests){
+#ifdef LIMB_SIMD_X86
+    using limb_t = LimbSimd::limb_t;
+    // runs of all-ones and zero limbs make carries and borrows ripple across vector boundaries
+    std::srand(23);
+    for (size_t n : {0, 1, 3, 4, 7, 8, 9, 31, 64, 257}) {
+        std::vector<limb_t> x(n), y(n);
+        for (size_t i = 0; i < n; i++) {
+            int kind = std::rand() % 4;
+            x[i] = kind == 0 ? ~0ull : kind == 1 ? 0 : (static_cast<limb_t>(std::rand()) << 32) ^ std::rand();
+            y[i] = kind == 0 ? (std::rand() % 2) : kind == 1 ? (std::rand() % 2) : (static_cast<limb_t>(std::rand()) << 33) ^ std::rand();
+        }
+        std::vector<limb_t> sum(n), diff(n);
+        limb_t carry = 0, borrow = 0;
+        for (size_t i = 0; i < n; i++) {
+            sum[i] = x[i] + y[i] + carry;
+            carry = carry ? sum[i] <= x[i] : sum[i] < x[i];
+            diff[i] = x[i] - y[i] - borrow;
+            borrow = borrow ? x[i] <= y[i] : x[i] < y[i];
+        }
+        std::vector<limb_t> out(n);
+        if (__builtin_cpu_supports("avx2")) {
+            EXPECT_EQ(LimbSimd::add_n_avx2(out.data(), x.data(), y.data(), n), carry);
+            EXPECT_EQ(out, sum);
+            EXPECT_EQ(LimbSimd::sub_n_avx2(out.data(), x.data(), y.data(), n), borrow);
+            EXPECT_EQ(out, diff);
+            out = y;
+            LimbSimd::sub_n_avx2(out.data(), x.data(), out.data(), n);
+            EXPECT_EQ(out, diff);
+        }
+        if (__builtin_cpu_supports("avx512f")) {
+            EXPECT_EQ(LimbSimd::add_n_avx512(out.data(), x.data(), y.data(), n), carry);
+            EXPECT_EQ(out, sum);
+            EXPECT_EQ(LimbSimd::sub_n_avx512(out.data(), x.data(), y.data(), n), borrow);
+            EXPECT_EQ(out, diff);
+            out = x;
+            LimbSimd::add_n_avx512(out.data(), out.data(), y.data(), n);
+            EXPECT_EQ(out, sum);
+        }
+    }
+#endif
+    UBigInt a{"340282366920938463463374607431768211455"}, b{1};
+    EXPECT_EQ(a + b, UBigInt("340282366920938463463374607431768211456"));
+    EXPECT_EQ(a + b - b, a);
+    EXPECT_EQ(a + a - UBigInt(a), a);
+    EXPECT_EQ(b - UBigInt(b), 0);
+}
+
+
+TEST (utility, cpu_dispatch_tests){
+    CpuDispatch::Level detected = CpuDispatch::supported();
+    EXPECT_STREQ(CpuDispatch::name(CpuDispatch::Level::avx2), "avx2");
+    std::srand(77);
+    std::vector<UBigInt> values;
+    for (size_t limbs : {1, 2, 3, 7, 8, 9, 33, 120}) {
+        values.push_back(UBigInt().randomize(limbs * 19));
+        values.push_back(pow(UBigInt(2), static_cast<std::uint64_t>(64 * limbs)) - 1);
+    }
+    auto run = [&values] {
+        std::vector<BigInt> results;
+        for (const UBigInt &a : values) {
+            for (const UBigInt &b : values) {
+                results.push_back(a * b);
+                results.push_back(a + b);
+                results.push_back(BigInt(a * a) - BigInt(b));
+                if (b != 0) {
+                    results.push_back(a * a % b);
+                    results.push_back(a * a / b);
+                }
+                BigInt acc{a};
+                submul(acc, BigInt(b), BigInt(b));
+                addmul(acc, BigInt(a), BigInt(b));
+                results.push_back(acc);
+            }
+        }
+        return results;
+    };
+    CpuDispatch::set_level(CpuDispatch::Level::generic);
+    std::vector<BigInt> expected = run();
+    for (CpuDispatch::Level level : {CpuDispatch::Level::bmi2, CpuDispatch::Level::avx2, CpuDispatch::Level::avx512}) {
+        CpuDispatch::set_level(level);
+        EXPECT_EQ(CpuDispatch::level(), level);
+        EXPECT_TRUE(run() == expected) << CpuDispatch::name(level);
+    }
+    CpuDispatch::set_level(detected);
+}